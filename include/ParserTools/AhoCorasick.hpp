@@ -0,0 +1,108 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "ByteSearch.hpp"
+
+/**
+ * @file
+ * @brief Defines the AhoCorasickAutomaton class.
+ */
+
+namespace ParserTools
+{
+    constexpr size_t NO_PATTERN = SIZE_MAX;
+
+    struct PatternMatch
+    {
+        size_t start = 0;
+        size_t end = 0;
+        /**
+         * @brief The index of the pattern that matched, or NO_PATTERN.
+         */
+        size_t pattern = NO_PATTERN;
+    };
+
+    /**
+     * @brief Searches strings for several patterns in a single pass.
+     *
+     * The automaton is a deterministic Aho-Corasick automaton stored as a
+     * flat transition table. Each distinct byte in the patterns has its
+     * own column in the table, and all other bytes share column 0, so the
+     * size of the table is the number of states times one more than the
+     * number of distinct bytes in the patterns.
+     */
+    class AhoCorasickAutomaton
+    {
+    public:
+        AhoCorasickAutomaton();
+
+        /**
+         * @brief Creates an automaton that searches for @a patterns.
+         *
+         * Empty patterns are ignored. If a pattern occurs more than once,
+         * matches are reported with the index of the first occurrence.
+         */
+        explicit AhoCorasickAutomaton(const std::vector<std::string_view>& patterns);
+
+        /**
+         * @brief Returns the leftmost match in @a str.
+         *
+         * If several patterns match at the same position, the longest
+         * one is returned. If there are no matches, both start and end are
+         * str.size() and pattern is NO_PATTERN.
+         */
+        [[nodiscard]] PatternMatch find(std::string_view str) const;
+
+        /**
+         * @brief Returns the index of the pattern that is equal to
+         *  @a str, or NO_PATTERN if there is none.
+         */
+        [[nodiscard]] size_t index_of(std::string_view str) const;
+
+        [[nodiscard]] size_t pattern_count() const;
+
+        [[nodiscard]] std::string_view pattern(size_t index) const;
+
+        [[nodiscard]] size_t max_pattern_length() const;
+
+        [[nodiscard]] size_t state_count() const;
+    private:
+        // Transitions have this bit set if the target state ends
+        // with a pattern.
+        static constexpr uint32_t MATCH_FLAG = 0x80000000u;
+
+        struct StateInfo
+        {
+            uint32_t depth = 0;
+            uint32_t own_pattern = uint32_t(NO_PATTERN);
+            uint32_t match_length = 0;
+            uint32_t match_pattern = uint32_t(NO_PATTERN);
+        };
+
+        [[nodiscard]] uint32_t next_state(uint32_t state, char c) const
+        {
+            return transitions_[state * class_count_ + classes_[uint8_t(c)]];
+        }
+
+        void build(const std::vector<std::string_view>& patterns);
+
+        std::vector<std::string> patterns_;
+        std::array<uint16_t, 256> classes_ = {};
+        size_t class_count_ = 1;
+        std::vector<uint32_t> transitions_;
+        std::vector<StateInfo> states_;
+        ByteSet first_bytes_;
+        size_t max_length_ = 0;
+    };
+}
@@ -0,0 +1,154 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+/**
+ * @file
+ * @brief Vectorized functions for finding bytes in strings.
+ *
+ * The functions use the instruction sets selected by simd_level().
+ */
+
+namespace ParserTools
+{
+    /**
+     * @brief A set of bytes with precomputed lookup tables.
+     *
+     * The set has a 256-entry membership table for scalar lookups, and
+     * nibble tables for the vectorized search functions. A byte b is in
+     * the set if
+     *
+     *     low_nibbles(i)[b & 0xF] & high_nibbles(i)[b >> 4]
+     *
+     * is non-zero for i = 0 or, if table_count() is 2, for i = 1. Each bit
+     * in the nibble tables identifies a set of low nibbles that is shared
+     * by one or more high nibbles. Sets where the high nibbles have more
+     * than eight different sets of low nibbles need the second pair
+     * of tables.
+     */
+    class ByteSet
+    {
+    public:
+        constexpr ByteSet() = default;
+
+        explicit constexpr ByteSet(std::string_view bytes)
+        {
+            std::array<uint16_t, 16> rows = {};
+            for (auto c : bytes)
+            {
+                auto b = uint8_t(c);
+                members_[b] = true;
+                rows[b >> 4u] |= uint16_t(1u << (b & 0xFu));
+            }
+
+            std::array<uint16_t, 16> row_bits = {};
+            size_t bit_count = 0;
+            for (size_t hi = 0; hi < 16; ++hi)
+            {
+                if (rows[hi] == 0)
+                    continue;
+
+                size_t bit = bit_count;
+                for (size_t i = 0; i < bit_count; ++i)
+                {
+                    if (row_bits[i] == rows[hi])
+                    {
+                        bit = i;
+                        break;
+                    }
+                }
+
+                if (bit == bit_count)
+                    row_bits[bit_count++] = rows[hi];
+
+                auto& hi_table = high_nibbles_[bit / 8];
+                auto& lo_table = low_nibbles_[bit / 8];
+                auto mask = uint8_t(1u << (bit % 8));
+                hi_table[hi] = mask;
+                for (size_t lo = 0; lo < 16; ++lo)
+                {
+                    if (rows[hi] & (1u << lo))
+                        lo_table[lo] |= mask;
+                }
+            }
+            table_count_ = bit_count > 8 ? 2 : 1;
+        }
+
+        [[nodiscard]]
+        constexpr bool contains(char c) const
+        {
+            return members_[uint8_t(c)];
+        }
+
+        [[nodiscard]]
+        constexpr const std::array<uint8_t, 16>& low_nibbles(size_t i) const
+        {
+            return low_nibbles_[i];
+        }
+
+        [[nodiscard]]
+        constexpr const std::array<uint8_t, 16>& high_nibbles(size_t i) const
+        {
+            return high_nibbles_[i];
+        }
+
+        [[nodiscard]]
+        constexpr size_t table_count() const
+        {
+            return table_count_;
+        }
+    private:
+        std::array<bool, 256> members_ = {};
+        std::array<std::array<uint8_t, 16>, 2> low_nibbles_ = {};
+        std::array<std::array<uint8_t, 16>, 2> high_nibbles_ = {};
+        size_t table_count_ = 1;
+    };
+
+    /**
+     * @brief Returns the position of the first occurrence of @a ch
+     *  in @a str, or str.size() if there is none.
+     */
+    [[nodiscard]] size_t find_byte(std::string_view str, char ch);
+
+    /**
+     * @brief Returns the position of occurrence number @a n of @a ch
+     *  in @a str, counting from 0, or str.size() if there are fewer
+     *  occurrences.
+     *
+     * The vectorized implementations count the occurrences in blocks of
+     * 64 bytes and skip blocks that don't contain the one they look for.
+     */
+    [[nodiscard]] size_t find_nth_byte(std::string_view str, char ch,
+                                       size_t n);
+
+    /**
+     * @brief Returns the position of the first '\\n' or '\\r' in @a str,
+     *  or str.size() if there is none.
+     */
+    [[nodiscard]] size_t find_newline_byte(std::string_view str);
+
+    /**
+     * @brief Returns the position of the first byte in @a str that is
+     *  in @a set, or str.size() if there is none.
+     *
+     * The SSE2 level does not have byte shuffles and uses the scalar
+     * implementation.
+     */
+    [[nodiscard]] size_t find_byte_in(std::string_view str, const ByteSet& set);
+
+    /**
+     * @brief Returns the position of the first byte in @a str that is
+     *  not in @a set, or str.size() if there is none.
+     */
+    [[nodiscard]] size_t find_byte_not_in(std::string_view str,
+                                          const ByteSet& set);
+}
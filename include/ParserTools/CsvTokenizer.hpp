@@ -0,0 +1,170 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <string>
+#include <string_view>
+#include <utility>
+
+/**
+ * @file
+ * @brief Tokenization of CSV and TSV data with quoted fields.
+ *
+ * FindCsvDelimiter is a delimiter finder for tokenize(), both for
+ * strings and streams:
+ *
+ *     std::string buffer;
+ *     for (auto item : tokenize(str, FindCsvDelimiter(',')))
+ *     {
+ *         auto value = unquote_csv_field(item.string(), buffer);
+ *         ...
+ *         if (FindCsvDelimiter::is_record_end(item.token()))
+ *             ...
+ *     }
+ *
+ * The tokens are the fields as they appear in the input, quotes
+ * included. unquote_csv_field only copies the fields that contain
+ * escaped quotes.
+ */
+
+namespace ParserTools
+{
+    namespace Details
+    {
+        /**
+         * @brief Returns the position of the first @a separator, '\\n'
+         *  or '\\r' in @a str that is outside quotes.
+         *
+         * @a str must start outside quotes. Uses the instruction sets
+         * selected by simd_level().
+         */
+        size_t find_csv_delimiter(std::string_view str, char separator,
+                                  char quote);
+    }
+
+    /**
+     * @brief Finds the separators and line breaks that are outside
+     *  quoted parts of the fields.
+     *
+     * The line breaks are "\n", "\r\n" and "\r". Each token must start
+     * outside quotes, which is the case when all of the data is
+     * tokenized from the beginning. Within a field, every quote
+     * character toggles whether the following characters are quoted,
+     * escaped quotes ("") therefore don't need special treatment.
+     * Unterminated quotes extend to the end of the input.
+     */
+    struct FindCsvDelimiter
+    {
+    public:
+        FindCsvDelimiter() = default;
+
+        explicit FindCsvDelimiter(char separator, char quote = '"')
+            : separator_(separator),
+              quote_(quote)
+        {}
+
+        std::pair<size_t, size_t> operator()(std::string_view str) const
+        {
+            auto from = Details::find_csv_delimiter(str, separator_, quote_);
+            auto to = from;
+            if (to != str.size() && str[to++] == '\r'
+                && to != str.size() && str[to] == '\n')
+            {
+                ++to;
+            }
+            return {from, to};
+        }
+
+        /**
+         * @brief Returns 0, whether a position is inside quotes is only
+         *  known when the search starts at the beginning of a field.
+         */
+        [[nodiscard]]
+        size_t resume_position(std::string_view, size_t) const
+        {
+            return 0;
+        }
+
+        /**
+         * @brief Returns false if the delimiter is a '\\r' at the end of
+         *  @a str that might be followed by '\\n'.
+         */
+        [[nodiscard]]
+        bool is_complete_delimiter(std::string_view str,
+                                   size_t start, size_t end) const
+        {
+            return end != str.size() || end - start == 2 || str[start] != '\r';
+        }
+
+        /**
+         * @brief Returns true if @a delimiter ends a record, i.e. it is
+         *  a line break or the end of the input.
+         */
+        [[nodiscard]]
+        static bool is_record_end(std::string_view delimiter)
+        {
+            return delimiter.empty() || delimiter[0] == '\n'
+                   || delimiter[0] == '\r';
+        }
+
+        [[nodiscard]]
+        char separator() const
+        {
+            return separator_;
+        }
+
+        [[nodiscard]]
+        char quote() const
+        {
+            return quote_;
+        }
+    private:
+        char separator_ = ',';
+        char quote_ = '"';
+    };
+
+    /**
+     * @brief Returns true if @a field starts and ends with @a quote.
+     */
+    constexpr bool is_quoted_csv_field(std::string_view field,
+                                       char quote = '"')
+    {
+        return field.size() >= 2 && field.front() == quote
+               && field.back() == quote;
+    }
+
+    /**
+     * @brief Returns the value of the CSV field @a field.
+     *
+     * Fields that aren't quoted are returned as they are. The quotes
+     * around quoted fields are removed, and if the field contains
+     * escaped quotes, the unescaped value is written to @a buffer and
+     * the returned string_view refers to @a buffer.
+     */
+    inline std::string_view unquote_csv_field(std::string_view field,
+                                              std::string& buffer,
+                                              char quote = '"')
+    {
+        if (!is_quoted_csv_field(field, quote))
+            return field;
+
+        field = field.substr(1, field.size() - 2);
+        auto pos = field.find(quote);
+        if (pos == std::string_view::npos)
+            return field;
+
+        buffer.assign(field.substr(0, pos));
+        while (pos != std::string_view::npos)
+        {
+            // Keep one of the two quotes.
+            auto next = field.find(quote, pos + 2);
+            buffer.append(field.substr(pos + 1, next - pos - 1));
+            pos = next;
+        }
+        return buffer;
+    }
+}
@@ -0,0 +1,54 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include "ParseResult.hpp"
+
+/**
+ * @file
+ * @brief Functions that decode strings of binary, octal or hexadecimal
+ *  digits to bytes.
+ *
+ * The digits are the same as those accepted by parse_integer, i.e.
+ * letters are case-insensitive, but underscores aren't allowed. The
+ * digits are a big-endian bit stream: the first digit holds the most
+ * significant bits of the first byte. The total number of bits must be
+ * a multiple of eight.
+ *
+ * The result's value is the number of bytes written to @a bytes. On
+ * error, @a size is the position of the first invalid digit, or the
+ * size of @a str if the digits don't make up a whole number of bytes,
+ * and @a error is std::errc::invalid_argument. If @a bytes is too
+ * small for the result, @a error is std::errc::result_out_of_range and
+ * nothing is decoded.
+ *
+ * The functions use the instruction sets selected by simd_level().
+ */
+
+namespace ParserTools
+{
+    /**
+     * @brief Decodes a string of hexadecimal digits, two per byte.
+     */
+    ParseResult<size_t> decode_hex(std::string_view str,
+                                   std::span<uint8_t> bytes);
+
+    /**
+     * @brief Decodes a string of octal digits, eight per three bytes.
+     */
+    ParseResult<size_t> decode_octal(std::string_view str,
+                                     std::span<uint8_t> bytes);
+
+    /**
+     * @brief Decodes a string of binary digits, eight per byte.
+     */
+    ParseResult<size_t> decode_binary(std::string_view str,
+                                      std::span<uint8_t> bytes);
+}
@@ -7,31 +7,133 @@
 //****************************************************************************
 #pragma once
 #include <algorithm>
+#include <memory>
 #include <string_view>
-#include <cctype>
+#include <utility>
+#include <vector>
+#include "AhoCorasick.hpp"
+#include "ByteSearch.hpp"
+#include "ResumableSearch.hpp"
+#include "SubstringSearch.hpp"
 
 namespace ParserTools
 {
+    namespace Details
+    {
+        /**
+         * @brief The characters that isspace accepts in the C locale.
+         */
+        inline constexpr ByteSet ASCII_WHITESPACE(" \t\n\v\f\r");
+
+        /**
+         * @brief The ASCII whitespace characters and the first bytes of
+         *  the UTF-8 encodings of the non-ASCII whitespace characters.
+         */
+        inline constexpr ByteSet UNICODE_WHITESPACE_START(
+            " \t\n\v\f\r\xC2\xE1\xE2\xE3");
+
+        /**
+         * @brief Returns the length of the UTF-8 encoded whitespace
+         *  character at the start of @a str, or 0 if it doesn't start with
+         *  whitespace.
+         *
+         * The whitespace characters are the ones with the Unicode
+         * White_Space property.
+         */
+        constexpr size_t get_whitespace_length(std::string_view str)
+        {
+            if (str.empty())
+                return 0;
+
+            auto c0 = uint8_t(str[0]);
+            if (c0 < 0x80)
+                return ASCII_WHITESPACE.contains(str[0]) ? 1 : 0;
+            if (str.size() < 2)
+                return 0;
+
+            auto c1 = uint8_t(str[1]);
+            if (c0 == 0xC2)
+                return c1 == 0x85 || c1 == 0xA0 ? 2 : 0; // U+0085, U+00A0
+            if (str.size() < 3)
+                return 0;
+
+            auto c2 = uint8_t(str[2]);
+            switch (c0)
+            {
+            case 0xE1: // U+1680
+                return c1 == 0x9A && c2 == 0x80 ? 3 : 0;
+            case 0xE2:
+                if (c1 == 0x80) // U+2000-U+200A, U+2028, U+2029, U+202F
+                    return (0x80 <= c2 && c2 <= 0x8A) || c2 == 0xA8 || c2 == 0xA9 || c2 == 0xAF ? 3 : 0;
+                return c1 == 0x81 && c2 == 0x9F ? 3 : 0; // U+205F
+            case 0xE3: // U+3000
+                return c1 == 0x80 && c2 == 0x80 ? 3 : 0;
+            default:
+                return 0;
+            }
+        }
+
+        /**
+         * @brief Returns true if @a str is the start of the UTF-8
+         *  encoding of a non-ASCII whitespace character, but too short to
+         *  be all of it.
+         */
+        constexpr bool is_partial_whitespace(std::string_view str)
+        {
+            if (str.empty() || str.size() > 2)
+                return false;
+
+            auto c0 = uint8_t(str[0]);
+            if (str.size() == 1)
+                return c0 == 0xC2 || (0xE1 <= c0 && c0 <= 0xE3);
+
+            auto c1 = uint8_t(str[1]);
+            switch (c0)
+            {
+            case 0xE1:
+                return c1 == 0x9A;
+            case 0xE2:
+                return c1 == 0x80 || c1 == 0x81;
+            case 0xE3:
+                return c1 == 0x80;
+            default:
+                return false;
+            }
+        }
+    }
+
     struct FindSubstring
     {
         FindSubstring() = default;
 
         explicit FindSubstring(std::string_view str)
-            : substring_(str)
+            : searcher_(str)
         {}
 
         std::pair<size_t, size_t> operator()(std::string_view str) const
         {
-            if (substring_.empty())
+            if (searcher_.needle().empty())
                 return {str.size(), str.size()};
-            auto it = std::search(str.begin(), str.end(),
-                                  substring_.begin(), substring_.end());
-            auto start = std::distance(str.begin(), it);
-            auto end = it != str.end() ? start + substring_.size() : start;
+            auto start = searcher_.find(str);
+            auto end = start != str.size() ? start + searcher_.needle().size()
+                                           : start;
             return {start, end};
         }
+
+        [[nodiscard]]
+        size_t resume_position(std::string_view str, size_t start) const
+        {
+            return Details::get_resume_position(str, start,
+                                                searcher_.needle().size());
+        }
+
+        [[nodiscard]]
+        bool is_complete_delimiter(std::string_view, size_t, size_t) const
+        {
+            return true;
+        }
     private:
-        std::string_view substring_;
+        SubstringSearcher searcher_;
     };
 
     struct FindChar
@@ -42,13 +144,30 @@ namespace ParserTools
             : char_(ch)
         {}
 
+        [[nodiscard]]
+        char character() const
+        {
+            return char_;
+        }
+
         std::pair<size_t, size_t> operator()(std::string_view str) const
         {
-            const auto it = std::find(str.begin(), str.end(), char_);
-            auto start = std::distance(str.begin(), it);
-            auto end = it != str.end() ? start + 1 : start;
+            const auto start = find_byte(str, char_);
+            auto end = start != str.size() ? start + 1 : start;
             return {start, end};
         }
+
+        [[nodiscard]]
+        size_t resume_position(std::string_view, size_t start) const
+        {
+            return start;
+        }
+
+        [[nodiscard]]
+        bool is_complete_delimiter(std::string_view, size_t, size_t) const
+        {
+            return true;
+        }
     private:
         char char_ = '\0';
     };
@@ -58,35 +177,223 @@ namespace ParserTools
     public:
         std::pair<size_t, size_t> operator()(std::string_view str) const
         {
-            auto from = std::find_if(str.begin(), str.end(),
-                                     [](char c){return c == '\n' || c == '\r';});
+            const auto from = find_newline_byte(str);
             auto to = from;
-            if (to != str.end() && *to++ == '\r'
-                && to != str.end() && *to == '\n')
+            if (to != str.size() && str[to++] == '\r'
+                && to != str.size() && str[to] == '\n')
             {
                 ++to;
             }
-            return {std::distance(str.begin(), from),
-                    std::distance(str.begin(), to)};
+            return {from, to};
         }
+
+        [[nodiscard]]
+        size_t resume_position(std::string_view, size_t start) const
+        {
+            return start;
+        }
+
+        /**
+         * @brief Returns false if the delimiter is a '\\r' at the end of
+         *  @a str that might be followed by '\\n'.
+         */
+        [[nodiscard]]
+        bool is_complete_delimiter(std::string_view str,
+                                   size_t start, size_t end) const
+        {
+            return end != str.size() || end - start == 2 || str[start] == '\n';
+        }
+    };
+
+    /**
+     * @brief Finds the lines that contain a given substring.
+     *
+     * Unlike the other finders, the interesting part is the delimiter:
+     * the "delimiter" is a whole line that contains the substring,
+     * without its line break, and the token is the text that was
+     * skipped before it:
+     *
+     *     for (auto item : tokenize(str, FindLineContaining("ERROR")))
+     *     {
+     *         if (item.token().empty())
+     *             break;
+     *         auto line = item.token();
+     *         ...
+     *     }
+     *
+     * The substring is searched for in the whole string, line breaks
+     * are only searched for around the matches, so the lines that don't
+     * match are never split. Line breaks are '\n' and '\r', and the
+     * substring can't contain them. Works with the stream tokenizers,
+     * a line that reaches the end of the buffer is completed before it
+     * is delivered. The finder remembers how much of such a line has
+     * been searched, so long lines are only searched once.
+     */
+    struct FindLineContaining
+    {
+        FindLineContaining() = default;
+
+        explicit FindLineContaining(std::string_view substring)
+            : searcher_(substring)
+        {}
+
+        std::pair<size_t, size_t> operator()(std::string_view str) const
+        {
+            // The state left by resume_position only applies to this
+            // search.
+            const auto from = std::min(std::exchange(skip_, 0), str.size());
+            if (std::exchange(line_matches_, false))
+                return {0, from + find_newline_byte(str.substr(from))};
+
+            if (searcher_.needle().empty())
+                return {str.size(), str.size()};
+            auto match = from + searcher_.find(str.substr(from));
+            if (match == str.size())
+            {
+                last_line_size_ = str.size() - get_line_start(str, from, match);
+                return {match, match};
+            }
+            auto end = match + searcher_.needle().size();
+            end += find_newline_byte(str.substr(end));
+            return {get_line_start(str, from, match), end};
+        }
+
+        /**
+         * @brief Returns the start of the last line in @a str, the
+         *  delimiter must include the whole line.
+         *
+         * The finder remembers how much of the line has been searched,
+         * the next search only searches the bytes that were appended to
+         * @a str and the last needle.size() - 1 bytes before them.
+         */
+        [[nodiscard]]
+        size_t resume_position(std::string_view str, size_t start) const
+        {
+            if (start != str.size())
+            {
+                // The line at start contains the substring, only the
+                // line break remains to be found.
+                line_matches_ = true;
+                skip_ = str.size() - start;
+                return start;
+            }
+            if (searcher_.needle().empty())
+                return start;
+
+            const auto line_size = std::min(last_line_size_, str.size());
+            skip_ = line_size - std::min(line_size, searcher_.needle().size() - 1);
+            return str.size() - line_size;
+        }
+
+        /**
+         * @brief Returns false if the line reaches the end of @a str, it
+         *  might continue in the data that hasn't been read yet.
+         */
+        [[nodiscard]]
+        bool is_complete_delimiter(std::string_view str, size_t, size_t end) const
+        {
+            return end != str.size();
+        }
+    private:
+        /**
+         * @brief Returns the start of the line that contains @a pos,
+         *  there are no line breaks before @a from.
+         */
+        static size_t get_line_start(std::string_view str, size_t from,
+                                     size_t pos)
+        {
+            auto newline = str.substr(from, pos - from).find_last_of("\r\n");
+            return newline == std::string_view::npos ? 0 : from + newline + 1;
+        }
+
+        SubstringSearcher searcher_;
+        // The number of bytes at the start of the next string that
+        // have already been searched.
+        mutable size_t skip_ = 0;
+        // The size of the last line in the most recent string without
+        // a match.
+        mutable size_t last_line_size_ = 0;
+        // True if the first line of the next string contains the
+        // substring.
+        mutable bool line_matches_ = false;
     };
 
+    /**
+     * @brief Finds sequences of ASCII whitespace.
+     *
+     * The whitespace characters are space, tab, newline, vertical tab,
+     * form feed and carriage return. The result does not depend on the
+     * current locale.
+     */
     struct FindWhitespace
     {
         std::pair<size_t, size_t> operator()(std::string_view str) const
         {
-            auto from = std::find_if(str.begin(), str.end(), [](char c)
+            auto from = find_byte_in(str, Details::ASCII_WHITESPACE);
+            auto to = from + find_byte_not_in(str.substr(from),
+                                              Details::ASCII_WHITESPACE);
+            return {from, to};
+        }
+
+        [[nodiscard]]
+        size_t resume_position(std::string_view, size_t start) const
+        {
+            return start;
+        }
+    };
+
+    /**
+     * @brief Finds sequences of Unicode whitespace in UTF-8 encoded text.
+     *
+     * ASCII text is searched as quickly as with FindWhitespace, only the
+     * bytes that can start a non-ASCII whitespace character are decoded.
+     */
+    struct FindUnicodeWhitespace
+    {
+        std::pair<size_t, size_t> operator()(std::string_view str) const
+        {
+            size_t from = 0;
+            while (true)
             {
-                return isspace(c) != 0;
-            });
+                from += find_byte_in(str.substr(from),
+                                     Details::UNICODE_WHITESPACE_START);
+                if (from == str.size())
+                    return {from, from};
+                if (Details::get_whitespace_length(str.substr(from)) != 0)
+                    break;
+                ++from;
+            }
 
-            auto to = std::find_if(from, str.end(), [](char c)
+            auto to = from;
+            while (to != str.size())
             {
-              return isspace(c) == 0;
-            });
+                to += find_byte_not_in(str.substr(to),
+                                       Details::ASCII_WHITESPACE);
+                auto length = Details::get_whitespace_length(str.substr(to));
+                if (length == 0)
+                    break;
+                to += length;
+            }
+            return {from, to};
+        }
+
+        [[nodiscard]]
+        size_t resume_position(std::string_view str, size_t start) const
+        {
+            // The longest whitespace characters are three bytes long.
+            return Details::get_resume_position(str, start, 3);
+        }
 
-            return {std::distance(str.begin(), from),
-                    std::distance(str.begin(), to)};
+        /**
+         * @brief Returns false if the whitespace reaches the end of
+         *  @a str, or is followed by the first bytes of a whitespace
+         *  character that was cut off at the end of @a str.
+         */
+        [[nodiscard]]
+        bool is_complete_delimiter(std::string_view str, size_t, size_t end) const
+        {
+            return end != str.size()
+                   && !Details::is_partial_whitespace(str.substr(end));
         }
     };
 
@@ -100,19 +407,147 @@ namespace ParserTools
 
         std::pair<size_t, size_t> operator()(std::string_view str) const
         {
-            auto match = [this](char c)
-                {
-                    return std::find(characters_.begin(),
-                                     characters_.end(),
-                                     c) != characters_.end();
-                };
-            auto from = std::find_if(str.begin(), str.end(), match);
-            auto to = std::find_if_not(from, str.end(), match);
-            return {std::distance(str.begin(), from),
-                    std::distance(str.begin(), to)};
+            auto from = find_byte_in(str, characters_);
+            auto to = from + find_byte_not_in(str.substr(from), characters_);
+            return {from, to};
+        }
+
+        [[nodiscard]]
+        size_t resume_position(std::string_view, size_t start) const
+        {
+            return start;
+        }
+
+    private:
+        ByteSet characters_;
+    };
+
+    /**
+     * @brief Finds the first character in a set of characters.
+     *
+     * Unlike FindSequenceOf, the delimiter is always a single character,
+     * consecutive delimiters produce empty tokens.
+     */
+    struct FindAnyOf
+    {
+        FindAnyOf() = default;
+
+        explicit FindAnyOf(std::string_view characters)
+            : characters_(characters)
+        {}
+
+        std::pair<size_t, size_t> operator()(std::string_view str) const
+        {
+            const auto start = find_byte_in(str, characters_);
+            auto end = start != str.size() ? start + 1 : start;
+            return {start, end};
+        }
+
+        [[nodiscard]]
+        size_t resume_position(std::string_view, size_t start) const
+        {
+            return start;
+        }
+
+        [[nodiscard]]
+        bool is_complete_delimiter(std::string_view, size_t, size_t) const
+        {
+            return true;
+        }
+
+    private:
+        ByteSet characters_;
+    };
+
+    /**
+     * @brief Finds the leftmost occurrence of any of several substrings.
+     *
+     * The substrings are found in a single pass with an Aho-Corasick
+     * automaton. If several substrings start at the same position, the
+     * longest is used. The automaton is shared between copies of the
+     * finder, which makes the finder cheap to copy.
+     */
+    struct FindAnyOfSubstrings
+    {
+        FindAnyOfSubstrings() = default;
+
+        explicit FindAnyOfSubstrings(const std::vector<std::string_view>& substrings)
+            : automaton_(std::make_shared<AhoCorasickAutomaton>(substrings))
+        {}
+
+        std::pair<size_t, size_t> operator()(std::string_view str) const
+        {
+            auto match = find(str);
+            return {match.start, match.end};
+        }
+
+        /**
+         * @brief Returns the leftmost match in @a str, including the index
+         *  of the substring that matched.
+         */
+        [[nodiscard]]
+        PatternMatch find(std::string_view str) const
+        {
+            if (!automaton_)
+                return {str.size(), str.size(), NO_PATTERN};
+            return automaton_->find(str);
+        }
+
+        /**
+         * @brief Returns the index of the substring that is equal to
+         *  @a delimiter, or NO_PATTERN if there is none.
+         *
+         * Use this function to identify the delimiter in the items
+         * returned by the tokenizers.
+         */
+        [[nodiscard]]
+        size_t index_of(std::string_view delimiter) const
+        {
+            return automaton_ ? automaton_->index_of(delimiter) : NO_PATTERN;
+        }
+
+        /**
+         * @brief Returns the position where a search can resume when more
+         *  bytes are appended to @a str.
+         *
+         * A longer substring that starts before @a start may be
+         * completed by the new bytes, so the last bytes of @a str are
+         * searched again.
+         */
+        [[nodiscard]]
+        size_t resume_position(std::string_view str, size_t start) const
+        {
+            if (!automaton_)
+                return start;
+            return Details::get_resume_position(str, start,
+                                                automaton_->max_pattern_length());
+        }
+
+        /**
+         * @brief Returns false if the text from @a start to the end of
+         *  @a str is the beginning of a longer substring.
+         *
+         * The match is the longest substring at @a start within @a str,
+         * but a longer one can be completed by bytes that haven't been
+         * read yet.
+         */
+        [[nodiscard]]
+        bool is_complete_delimiter(std::string_view str,
+                                   size_t start, size_t) const
+        {
+            const auto tail = str.substr(start);
+            if (!automaton_ || tail.size() >= automaton_->max_pattern_length())
+                return true;
+            for (size_t i = 0; i < automaton_->pattern_count(); ++i)
+            {
+                auto pattern = automaton_->pattern(i);
+                if (pattern.size() > tail.size() && pattern.starts_with(tail))
+                    return false;
+            }
+            return true;
         }
 
     private:
-        std::string_view characters_;
+        std::shared_ptr<const AhoCorasickAutomaton> automaton_;
     };
 }
@@ -0,0 +1,127 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string_view>
+
+/**
+ * @file
+ * @brief Defines the MappedFile class.
+ */
+
+namespace ParserTools
+{
+    constexpr size_t DEFAULT_MAX_MAPPING_SIZE =
+        sizeof(void*) >= 8 ? SIZE_MAX : size_t(256) * 1024 * 1024;
+
+    struct MappedFileOptions
+    {
+        /**
+         * @brief Tell the operating system that the file will be read
+         *  sequentially (MADV_SEQUENTIAL or FILE_FLAG_SEQUENTIAL_SCAN).
+         */
+        bool sequential = true;
+
+        /**
+         * @brief Ask for transparent huge pages (MADV_HUGEPAGE).
+         *
+         * Only has an effect on Linux, and only on file systems
+         * that support huge pages in the page cache.
+         */
+        bool huge_pages = false;
+
+        /**
+         * @brief The largest part of the file that is mapped at a time.
+         *
+         * Files that are larger than this are mapped in a sliding window
+         * that is moved forward by fill().
+         */
+        size_t max_mapping_size = DEFAULT_MAX_MAPPING_SIZE;
+    };
+
+    namespace Details
+    {
+        struct MappedFileContext;
+    }
+
+    /**
+     * @brief A read-only memory-mapped file.
+     *
+     * If the entire file fits within MappedFileOptions::max_mapping_size,
+     * string() returns the whole file and it can be tokenized in place
+     * with StringTokenizer, split etc.
+     *
+     * Larger files are mapped in a sliding window. The class has the same
+     * interface as StreamBuffer: string() returns the unconsumed part of
+     * the window, consume() marks bytes as used and fill() moves the
+     * window forward. A MappedFile can therefore be tokenized with
+     * StreamTokenizer regardless of its size, see tokenize().
+     *
+     * The file must not be truncated while it is mapped.
+     */
+    class MappedFile
+    {
+    public:
+        MappedFile();
+
+        explicit MappedFile(const std::filesystem::path& path,
+                            const MappedFileOptions& options = {});
+
+        MappedFile(const MappedFile&) = delete;
+
+        MappedFile(MappedFile&& other) noexcept;
+
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        MappedFile& operator=(MappedFile&& other) noexcept;
+
+        ~MappedFile();
+
+        explicit operator bool() const
+        {
+            return context_ != nullptr;
+        }
+
+        [[nodiscard]] size_t file_size() const;
+
+        /**
+         * @brief Returns true if only a part of the file is mapped
+         *  at a time.
+         */
+        [[nodiscard]] bool is_windowed() const;
+
+        [[nodiscard]]
+        std::string_view string() const
+        {
+            return {data_ + offset_, size_ - offset_};
+        }
+
+        void consume(size_t size)
+        {
+            offset_ += size;
+        }
+
+        /**
+         * @brief Moves the window so it starts at the unconsumed data and
+         *  includes more of the file.
+         *
+         * @return false if the window already reaches the end of the file.
+         */
+        bool fill();
+
+        void close();
+    private:
+        std::unique_ptr<Details::MappedFileContext> context_;
+        const char* data_ = nullptr;
+        size_t offset_ = 0;
+        size_t size_ = 0;
+    };
+}
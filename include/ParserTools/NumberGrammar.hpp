@@ -0,0 +1,80 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+
+namespace ParserTools
+{
+    /**
+     * @brief Selects the syntax accepted by the number parsers at
+     *  compile time.
+     *
+     * Used as a template argument:
+     *
+     *     parse_integer<int, DECIMAL_NUMBER_GRAMMAR>(str)
+     *
+     * Every feature that is turned off is removed from the parser's
+     * loops, not just skipped.
+     */
+    struct NumberGrammar
+    {
+        /**
+         * @brief Accept integers prefixed with "0b" or "0B".
+         */
+        bool binary_prefix = true;
+        /**
+         * @brief Accept integers prefixed with "0o" or "0O".
+         */
+        bool octal_prefix = true;
+        /**
+         * @brief Accept integers prefixed with "0x" or "0X".
+         */
+        bool hexadecimal_prefix = true;
+        /**
+         * @brief Accept single underscores between digits.
+         */
+        bool underscores = true;
+        /**
+         * @brief Accept a leading '+'.
+         */
+        bool plus_sign = true;
+        /**
+         * @brief Accept "true" (1) and "false" (0) as integers.
+         */
+        bool boolean_keywords = true;
+        /**
+         * @brief Accept "null", as 0 for integers and infinity for
+         *  floating point numbers.
+         */
+        bool null_keyword = true;
+        /**
+         * @brief Accept "Infinity", "+Infinity", "-Infinity" and "NaN"
+         *  as floating point numbers.
+         */
+        bool infinity_and_nan = true;
+    };
+
+    /**
+     * @brief Everything the number parsers accept.
+     */
+    constexpr NumberGrammar DEFAULT_NUMBER_GRAMMAR = {};
+
+    /**
+     * @brief Plain decimal numbers with an optional '-', like "-12"
+     *  and "1.5e3".
+     */
+    constexpr NumberGrammar DECIMAL_NUMBER_GRAMMAR = {
+        .binary_prefix = false,
+        .octal_prefix = false,
+        .hexadecimal_prefix = false,
+        .underscores = false,
+        .plus_sign = false,
+        .boolean_keywords = false,
+        .null_keyword = false,
+        .infinity_and_nan = false
+    };
+}
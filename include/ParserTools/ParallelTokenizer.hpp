@@ -0,0 +1,132 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <algorithm>
+#include <string_view>
+#include <vector>
+#include "ResumableSearch.hpp"
+#include "StringTokenizer.hpp"
+#include "ThreadPool.hpp"
+
+/**
+ * @file
+ * @brief Functions that tokenize large strings on several threads.
+ *
+ * The string is cut into chunks of roughly the same size, and each cut
+ * is moved forward to the end of the first delimiter after it. Each chunk
+ * is then tokenized on its own, and produces the same tokens as the
+ * corresponding part of tokenize(str, finder).
+ *
+ * This only works with finders whose delimiters are recognized the same
+ * way wherever the search starts, for instance FindChar, FindNewline,
+ * FindAnyOf, FindSequenceOf, FindWhitespace and FindSubstring with
+ * a needle that can't overlap itself.
+ */
+
+namespace ParserTools
+{
+    constexpr size_t DEFAULT_PARALLEL_CHUNK_SIZE = 1024 * 1024;
+
+    /**
+     * @brief Splits @a str into chunks of approximately @a chunk_size
+     *  bytes that end at the end of a delimiter.
+     *
+     * The search for the delimiter following each cut is limited to
+     * @a chunk_size bytes. If no delimiter is found, the chunk is merged
+     * with the next one.
+     */
+    template <typename FindDelimiterFunc>
+    std::vector<std::string_view>
+    get_tokenizer_chunks(std::string_view str,
+                         FindDelimiterFunc find_delimiter_func,
+                         size_t chunk_size = DEFAULT_PARALLEL_CHUNK_SIZE)
+    {
+        chunk_size = std::max<size_t>(chunk_size, 1);
+        std::vector<std::string_view> result;
+        size_t start = 0;
+        for (size_t cut = chunk_size; cut < str.size(); cut += chunk_size)
+        {
+            if (cut < start)
+                continue;
+            auto window = str.substr(cut, chunk_size);
+            auto [s, e] = find_delimiter_func(window);
+            // The delimiter might continue beyond the window.
+            if (s == e || (cut + window.size() != str.size()
+                           && !Details::is_complete_delimiter(
+                               find_delimiter_func, window, s, e)))
+            {
+                continue;
+            }
+            auto end = cut + e;
+            result.push_back(str.substr(start, end - start));
+            start = end;
+        }
+        // An empty string is a single chunk, it has a single empty token.
+        if (start != str.size() || result.empty())
+            result.push_back(str.substr(start));
+        return result;
+    }
+
+    /**
+     * @brief Tokenizes @a str on the threads in @a pool, calling
+     *  @a callback(chunk_index, tokenizer) for each chunk.
+     *
+     * The callbacks are made concurrently and in no particular order.
+     * The tokenizer is a StringTokenizer for the chunk, and
+     * @a chunk_index is the chunk's index in the list returned by
+     * get_tokenizer_chunks().
+     */
+    template <typename FindDelimiterFunc, typename ChunkCallback>
+    void parallel_tokenize(ThreadPool& pool,
+                           std::string_view str,
+                           FindDelimiterFunc find_delimiter_func,
+                           ChunkCallback&& callback,
+                           size_t chunk_size = DEFAULT_PARALLEL_CHUNK_SIZE)
+    {
+        auto chunks = get_tokenizer_chunks(str, find_delimiter_func,
+                                           chunk_size);
+        pool.run(chunks.size(), [&](size_t i)
+        {
+            callback(i, tokenize(chunks[i], find_delimiter_func));
+        });
+    }
+
+    /**
+     * @brief Tokenizes @a str on the threads in @a pool and returns
+     *  the tokens in order.
+     *
+     * The result is the same as collecting item.string() for every item
+     * in tokenize(str, find_delimiter_func).
+     */
+    template <typename FindDelimiterFunc>
+    std::vector<std::string_view>
+    parallel_get_tokens(ThreadPool& pool,
+                        std::string_view str,
+                        FindDelimiterFunc find_delimiter_func,
+                        size_t chunk_size = DEFAULT_PARALLEL_CHUNK_SIZE)
+    {
+        auto chunks = get_tokenizer_chunks(str, find_delimiter_func,
+                                           chunk_size);
+        std::vector<std::vector<std::string_view>> chunk_tokens(chunks.size());
+        pool.run(chunks.size(), [&](size_t i)
+        {
+            for (auto item : tokenize(chunks[i], find_delimiter_func))
+                chunk_tokens[i].push_back(item.string());
+        });
+
+        size_t count = 0;
+        for (const auto& tokens : chunk_tokens)
+            count += tokens.size();
+
+        std::vector<std::string_view> result;
+        result.reserve(count);
+        for (const auto& tokens : chunk_tokens)
+            result.insert(result.end(), tokens.begin(), tokens.end());
+        return result;
+    }
+}
@@ -0,0 +1,235 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <string_view>
+#include <type_traits>
+#include "ParseInteger.hpp"
+
+/**
+ * @file
+ * @brief Functions that parse decimal numbers as fixed-point integers.
+ */
+
+namespace ParserTools
+{
+    /**
+     * @brief What parse_decimal does with fraction digits beyond the
+     *  scale.
+     */
+    enum class DecimalRounding
+    {
+        /**
+         * @brief Fail if any of the excess digits is non-zero.
+         */
+        REJECT,
+        /**
+         * @brief Ignore the excess digits, i.e. round towards zero.
+         */
+        TRUNCATE,
+        /**
+         * @brief Round to nearest, ties away from zero.
+         */
+        HALF_UP,
+        /**
+         * @brief Round to nearest, ties to even.
+         */
+        HALF_EVEN
+    };
+
+    namespace Details
+    {
+        constexpr uint64_t DECIMAL_POWERS_OF_TEN[] = {
+            1u,
+            10u,
+            100u,
+            1000u,
+            10000u,
+            100000u,
+            1000000u,
+            10000000u,
+            100000000u,
+            1000000000u,
+            10000000000u,
+            100000000000u,
+            1000000000000u,
+            10000000000000u,
+            100000000000000u,
+            1000000000000000u,
+            10000000000000000u,
+            100000000000000000u,
+            1000000000000000000u,
+            10000000000000000000u
+        };
+
+        /**
+         * @brief Parses up to @a max_digits decimal digits starting at
+         *  @a i in @a str, and adds them to @a value.
+         *
+         * Single underscores between the digits are skipped if
+         * @a Underscores is true. Returns the position after the last
+         * digit, @a count is increased by the number of digits.
+         */
+        template <typename U, bool Underscores>
+        size_t parse_fraction_digits(std::string_view str, size_t i,
+                                     size_t max_digits,
+                                     U& value, size_t& count)
+        {
+            while (count < max_digits)
+            {
+                U chunk = 0;
+                auto n = parse_decimal_prefix(str.substr(i, max_digits - count),
+                                              chunk);
+                value = U(value * DECIMAL_POWERS_OF_TEN[n] + chunk);
+                count += n;
+                i += n;
+                if (n == 0 || count == max_digits || !Underscores
+                    || i + 1 >= str.size() || str[i] != '_'
+                    || uint8_t(str[i + 1] - '0') > 9)
+                {
+                    break;
+                }
+                ++i;
+            }
+            return i;
+        }
+    }
+
+    /**
+     * @brief Parses the decimal number at the start of @a str as an
+     *  integer scaled by 10 to the power of @a Scale.
+     *
+     * With Scale 4, "12345.6789" is parsed as 123456789 and "-1.5" as
+     * -15000. The number must start with a digit, after the optional
+     * sign, and there is no exponent. Fraction digits beyond @a Scale
+     * are handled as selected by @a Rounding; with
+     * DecimalRounding::REJECT the error is std::errc::invalid_argument
+     * and @a size is the position of the first non-zero excess digit.
+     *
+     * Of @a Grammar only plus_sign and underscores are relevant.
+     */
+    template <typename IntT, unsigned Scale,
+              DecimalRounding Rounding = DecimalRounding::REJECT,
+              NumberGrammar Grammar = DEFAULT_NUMBER_GRAMMAR>
+    ParseResult<IntT> parse_decimal_prefix(std::string_view str)
+    {
+        static_assert(std::is_integral<IntT>());
+        using U = std::make_unsigned_t<IntT>;
+        static_assert(Scale <= unsigned(std::numeric_limits<U>::digits10)
+                      && Scale < std::size(Details::DECIMAL_POWERS_OF_TEN),
+                      "Scale is too large for IntT.");
+        constexpr bool UNDERSCORES = Grammar.underscores;
+        constexpr auto SCALE_FACTOR = U(Details::DECIMAL_POWERS_OF_TEN[Scale]);
+
+        size_t i = 0;
+        bool negative = false;
+        if (!str.empty() && (str[0] == '-' || (Grammar.plus_sign && str[0] == '+')))
+        {
+            negative = str[0] == '-';
+            ++i;
+        }
+
+        constexpr auto MAX_POSITIVE = U(std::numeric_limits<IntT>::max());
+        constexpr auto MAX_NEGATIVE = std::is_signed_v<IntT>
+                                      ? U(MAX_POSITIVE + 1u) : U(0);
+        const U limit = negative ? MAX_NEGATIVE : MAX_POSITIVE;
+
+        // Get the integer value.
+        auto integer = Details::parse_integer_digits<U, 10, UNDERSCORES>(str, i, false);
+        if (!integer)
+            return {{}, integer.size, integer.error};
+        if (integer.value > limit / SCALE_FACTOR)
+            return {{}, i, std::errc::result_out_of_range};
+        const auto number_start = i;
+        U value = U(integer.value * SCALE_FACTOR);
+        i = integer.size;
+
+        // Get the fraction, the digits that fit within the scale first.
+        if (i == str.size() || str[i] != '.')
+            return {negative ? IntT(U(U(0) - value)) : IntT(value), i, {}};
+        ++i;
+
+        U fraction = 0;
+        size_t fraction_digits = 0;
+        i = Details::parse_fraction_digits<U, UNDERSCORES>(str, i, Scale,
+                                                           fraction,
+                                                           fraction_digits);
+        fraction = U(fraction * Details::DECIMAL_POWERS_OF_TEN[Scale - fraction_digits]);
+
+        // Then the excess digits, only the first one and whether any of
+        // the others are non-zero matter.
+        unsigned first_excess = 0;
+        bool sticky = false;
+        size_t first_non_zero = str.size();
+        bool has_excess = false;
+        if (fraction_digits == Scale)
+        {
+            for (; i < str.size(); ++i)
+            {
+                auto digit = uint8_t(str[i] - '0');
+                if (digit <= 9)
+                {
+                    if (digit != 0 && first_non_zero == str.size())
+                        first_non_zero = i;
+                    if (!has_excess)
+                        first_excess = digit;
+                    else
+                        sticky |= digit != 0;
+                    has_excess = true;
+                }
+                else if (!UNDERSCORES || str[i] != '_'
+                         || str[i - 1] == '.' || i + 1 == str.size()
+                         || uint8_t(str[i + 1] - '0') > 9)
+                {
+                    break;
+                }
+            }
+        }
+
+        bool round_up = false;
+        if constexpr (Rounding == DecimalRounding::REJECT)
+        {
+            if (first_non_zero != str.size())
+                return {{}, first_non_zero, std::errc::invalid_argument};
+        }
+        else if constexpr (Rounding == DecimalRounding::HALF_UP)
+        {
+            round_up = first_excess >= 5;
+        }
+        else if constexpr (Rounding == DecimalRounding::HALF_EVEN)
+        {
+            round_up = first_excess > 5
+                       || (first_excess == 5 && (sticky || (U(value + fraction) & 1u)));
+        }
+
+        if (fraction > limit - value || (round_up && fraction == limit - value))
+            return {{}, number_start, std::errc::result_out_of_range};
+        value = U(value + fraction + U(round_up));
+        return {negative ? IntT(U(U(0) - value)) : IntT(value), i, {}};
+    }
+
+    /**
+     * @brief Parses @a str as a decimal number scaled by 10 to the
+     *  power of @a Scale.
+     *
+     * See parse_decimal_prefix for details.
+     */
+    template <typename IntT, unsigned Scale,
+              DecimalRounding Rounding = DecimalRounding::REJECT,
+              NumberGrammar Grammar = DEFAULT_NUMBER_GRAMMAR>
+    std::optional<IntT> parse_decimal(std::string_view str)
+    {
+        auto result = parse_decimal_prefix<IntT, Scale, Rounding, Grammar>(str);
+        if (!result || result.size != str.size())
+            return {};
+        return result.value;
+    }
+}
@@ -6,169 +6,301 @@
 // License text is included with the source distribution.
 //****************************************************************************
 #pragma once
-#include <cmath>
+#include <algorithm>
 #include <cstdint>
 #include <limits>
 #include <optional>
 #include <string_view>
+#include <type_traits>
+#include "NumberGrammar.hpp"
+#include "ParseResult.hpp"
 
 namespace ParserTools
 {
     namespace Details
     {
-        int get_digit(char c)
+        constexpr int get_digit(char c)
         {
             return int(uint8_t(c) ^ 0x30u);
         }
+
+        /**
+         * @brief The number of significant decimal digits that are
+         *  collected in the 64-bit mantissa.
+         */
+        constexpr int MAX_MANTISSA_DIGITS = 19;
+
+        /**
+         * @brief Larger explicit exponents are clamped to this value,
+         *  the numbers are then zero or infinity anyway.
+         */
+        constexpr int MAX_EXPLICIT_EXPONENT = 100000;
+
+        /**
+         * @brief Returns the double nearest to
+         *  @a mantissa * 10^@a exponent.
+         *
+         * If @a truncated is true, @a mantissa is the first
+         * MAX_MANTISSA_DIGITS significant digits of the number in
+         * @a str, and @a str is parsed digit by digit if the truncated
+         * digits can affect the result.
+         */
+        double decimal_to_double(uint64_t mantissa, int64_t exponent,
+                                 bool truncated, std::string_view str);
+
+        /**
+         * @brief The float counterpart of decimal_to_double.
+         */
+        float decimal_to_float(uint64_t mantissa, int64_t exponent,
+                               bool truncated, std::string_view str);
+
+        constexpr double EXACT_POWERS_OF_TEN[] = {
+            1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+            1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+        };
+
+        template <typename T>
+        struct FloatingPointTraits;
+
+        template <>
+        struct FloatingPointTraits<double>
+        {
+            static constexpr int64_t MAX_EXACT_EXPONENT = 22;
+            static constexpr uint64_t MAX_EXACT_MANTISSA = uint64_t(1) << 53;
+        };
+
+        template <>
+        struct FloatingPointTraits<float>
+        {
+            static constexpr int64_t MAX_EXACT_EXPONENT = 10;
+            static constexpr uint64_t MAX_EXACT_MANTISSA = uint64_t(1) << 24;
+        };
+
+        template <typename T>
+        T decimal_to_binary(uint64_t mantissa, int64_t exponent,
+                            bool truncated, std::string_view str)
+        {
+            using Traits = FloatingPointTraits<T>;
+            // Both the mantissa and the power of ten are exact, so
+            // a single multiplication or division is correctly rounded.
+            if (!truncated && mantissa <= Traits::MAX_EXACT_MANTISSA
+                && -Traits::MAX_EXACT_EXPONENT <= exponent
+                && exponent <= Traits::MAX_EXACT_EXPONENT)
+            {
+                auto value = T(mantissa);
+                if (exponent < 0)
+                    return value / T(EXACT_POWERS_OF_TEN[-exponent]);
+                return value * T(EXACT_POWERS_OF_TEN[exponent]);
+            }
+
+            if constexpr (std::is_same_v<T, double>)
+                return decimal_to_double(mantissa, exponent, truncated, str);
+            else
+                return decimal_to_float(mantissa, exponent, truncated, str);
+        }
     }
 
-    template <typename T>
-    std::optional<T> parse_floating_point(std::string_view str)
+    /**
+     * @brief Parses the floating point number at the start of @a str,
+     *  accepting the syntax selected by @a Grammar.
+     *
+     * See the overload without @a Grammar for details.
+     */
+    template <typename T, NumberGrammar Grammar>
+    ParseResult<T> parse_floating_point_prefix(std::string_view str)
     {
-        if (str.empty())
-            return {};
+        static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>,
+                      "T must be float or double.");
+
+        auto is_digit = [&](size_t i)
+        {
+            return i < str.size() && Details::get_digit(str[i]) <= 9;
+        };
 
         size_t i = 0;
         // Get the sign of the number
         bool negative = false;
-        if (str[0] == '-')
+        if (!str.empty() && (str[0] == '-' || (Grammar.plus_sign && str[0] == '+')))
         {
-            negative = true;
-            if (++i == str.size())
-                return {};
-        }
-        else if (str[0] == '+')
-        {
-            if (++i == str.size())
-                return {};
+            negative = str[0] == '-';
+            ++i;
         }
 
-        // Get the integer value
-        auto value = T(Details::get_digit(str[i]));
-        if (value > 9)
+        // Where an overflow is reported, the exponent if there is one.
+        size_t error_pos = i;
+
+        if (!is_digit(i))
         {
-            if (str == "Infinity" || str == "null" || str == "+Infinity")
-                return std::numeric_limits<T>::infinity();
-            if (str == "-Infinity")
-                return -std::numeric_limits<T>::infinity();
-            if (str == "NaN")
-                return std::numeric_limits<T>::quiet_NaN();
-            return {};
+            auto word = str.substr(i);
+            if constexpr (Grammar.infinity_and_nan)
+            {
+                if (word.starts_with("Infinity"))
+                {
+                    auto infinity = std::numeric_limits<T>::infinity();
+                    return {negative ? -infinity : infinity, i + 8, {}};
+                }
+                if (i == 0 && word.starts_with("NaN"))
+                    return {std::numeric_limits<T>::quiet_NaN(), 3, {}};
+            }
+            if constexpr (Grammar.null_keyword)
+            {
+                if (i == 0 && word.starts_with("null"))
+                    return {std::numeric_limits<T>::infinity(), 4, {}};
+            }
+            return {{}, i, std::errc::invalid_argument};
         }
 
-        bool underscore = false;
-        for (++i; i < str.size(); ++i)
+        // The first MAX_MANTISSA_DIGITS significant digits are collected
+        // in mantissa, exponent is adjusted for the fraction digits
+        // in mantissa and the integer digits that didn't fit.
+        uint64_t mantissa = 0;
+        int digits = 0;
+        int64_t exponent = 0;
+        bool truncated = false;
+
+        // Get the integer value. Underscores are only skipped when they
+        // are followed by a digit.
+        for (; i < str.size(); ++i)
         {
             auto digit = Details::get_digit(str[i]);
             if (digit <= 9)
             {
-                value *= 10;
-                value += digit;
-                underscore = false;
+                if (digits < Details::MAX_MANTISSA_DIGITS)
+                {
+                    mantissa = mantissa * 10 + unsigned(digit);
+                    digits += mantissa != 0;
+                }
+                else
+                {
+                    ++exponent;
+                    truncated |= digit != 0;
+                }
             }
-            else if (str[i] != '_' || underscore)
+            else if (!Grammar.underscores || str[i] != '_' || !is_digit(i + 1))
             {
                 break;
             }
-            else
-            {
-                underscore = true;
-            }
         }
 
-        if (underscore)
-            return {};
-
-        if (i == str.size())
-            return !negative ? value : -value;
-
         // Get the fraction
-        underscore = true; // Makes underscore after point illegal.
-        int decimals = 0;
-        T fraction = {};
-        if (str[i] == '.')
+        if (i != str.size() && str[i] == '.')
         {
             for (++i; i < str.size(); ++i)
             {
                 auto digit = Details::get_digit(str[i]);
                 if (digit <= 9)
                 {
-                    fraction *= 10;
-                    fraction += digit;
-                    underscore = false;
-                    ++decimals;
+                    if (digits < Details::MAX_MANTISSA_DIGITS)
+                    {
+                        mantissa = mantissa * 10 + unsigned(digit);
+                        digits += mantissa != 0;
+                        --exponent;
+                    }
+                    else
+                    {
+                        truncated |= digit != 0;
+                    }
                 }
-                else if (str[i] != '_' || underscore)
+                else if (!Grammar.underscores || str[i] != '_'
+                         || str[i - 1] == '.' || !is_digit(i + 1))
                 {
                     break;
                 }
-                else
-                {
-                    underscore = true;
-                }
             }
         }
 
-        // Get the exponent
-        int exponent = 0;
-        if (i != str.size())
+        // Get the exponent, it is only part of the number if it has
+        // at least one digit.
+        if (i != str.size() && (uint8_t(str[i]) & 0xDFu) == 'E')
         {
-            if ((uint8_t(str[i]) & 0xDFu) != 'E')
-                return {};
-
-            if (++i == str.size())
-                return {};
-
+            auto j = i + 1;
             bool negative_exponent = false;
-            if (str[i] == '-')
-            {
-                negative_exponent = true;
-                if (++i == str.size())
-                    return {};
-            }
-            else if (str[i] == '+')
-            {
-                if (++i == str.size())
-                    return {};
-            }
-
-            exponent += Details::get_digit(str[i]);
-            if (exponent > 9)
-                return {};
+            if (j != str.size() && (str[j] == '-' || str[j] == '+'))
+                negative_exponent = str[j++] == '-';
 
-            for (++i; i != str.size(); ++i)
+            if (is_digit(j))
             {
-                auto digit = Details::get_digit(str[i]);
-                if (digit <= 9)
-                {
-                    exponent *= 10;
-                    exponent += digit;
-                    underscore = false;
-                }
-                else if (str[i] != '_' || underscore)
+                const auto exponent_start = j;
+                int explicit_exponent = 0;
+                for (; j < str.size(); ++j)
                 {
-                    return {};
-                }
-                else
-                {
-                    underscore = true;
+                    auto digit = Details::get_digit(str[j]);
+                    if (digit <= 9)
+                    {
+                        explicit_exponent = explicit_exponent * 10 + digit;
+                    }
+                    else if (!Grammar.underscores || str[j] != '_'
+                             || !is_digit(j + 1))
+                    {
+                        break;
+                    }
+
+                    explicit_exponent = std::min(explicit_exponent,
+                                                 Details::MAX_EXPLICIT_EXPONENT);
                 }
-                if (exponent > std::numeric_limits<T>::max_exponent10)
-                    return {};
+                exponent += negative_exponent ? -explicit_exponent
+                                              : explicit_exponent;
+                error_pos = exponent_start;
+                i = j;
             }
-            if (negative_exponent)
-                exponent = -exponent;
         }
 
-        if (fraction)
-            value += fraction * std::pow(T(10), T(-decimals));
-        if (exponent)
-            value *= std::pow(T(10), T(exponent));
+        T value = 0;
+        if (mantissa != 0)
+        {
+            value = Details::decimal_to_binary<T>(mantissa, exponent,
+                                                  truncated, str.substr(0, i));
+            if (value == std::numeric_limits<T>::infinity())
+                return {{}, error_pos, std::errc::result_out_of_range};
+        }
 
         // Add the sign
-        if (negative)
-            value = -value;
+        return {negative ? -value : value, i, {}};
+    }
 
-        return value;
+    /**
+     * @brief Parses the floating point number at the start of @a str
+     *  and returns the nearest representable value.
+     *
+     * Parsing stops at the first character that can't be part of the
+     * number, like std::from_chars. Digits in the integer part, the
+     * fraction and the exponent can be separated by single underscores.
+     * The strings "Infinity", "+Infinity", "-Infinity", "NaN" and "null"
+     * (infinity) are also accepted. Numbers that round to a value larger
+     * than the largest finite value of T give
+     * std::errc::result_out_of_range, with @a size at the start of the
+     * exponent, or of the digits if there is no exponent. Values that are
+     * too small for T become zero.
+     */
+    template <typename T>
+    ParseResult<T> parse_floating_point_prefix(std::string_view str)
+    {
+        return parse_floating_point_prefix<T, DEFAULT_NUMBER_GRAMMAR>(str);
+    }
+
+    /**
+     * @brief Parses a floating point number, accepting the syntax
+     *  selected by @a Grammar.
+     */
+    template <typename T, NumberGrammar Grammar>
+    std::optional<T> parse_floating_point(std::string_view str)
+    {
+        auto result = parse_floating_point_prefix<T, Grammar>(str);
+        if (!result || result.size != str.size())
+            return {};
+        return result.value;
+    }
+
+    /**
+     * @brief Parses a floating point number and returns the nearest
+     *  representable value.
+     *
+     * The entire string must be a number as accepted by
+     * parse_floating_point_prefix.
+     */
+    template <typename T>
+    std::optional<T> parse_floating_point(std::string_view str)
+    {
+        return parse_floating_point<T, DEFAULT_NUMBER_GRAMMAR>(str);
     }
 }
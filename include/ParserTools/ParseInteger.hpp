@@ -6,11 +6,16 @@
 // License text is included with the source distribution.
 //****************************************************************************
 #pragma once
+#include <algorithm>
+#include <bit>
 #include <cstdint>
+#include <cstring>
 #include <limits>
 #include <optional>
 #include <string_view>
 #include <type_traits>
+#include "NumberGrammar.hpp"
+#include "ParseResult.hpp"
 
 namespace ParserTools
 {
@@ -28,183 +33,250 @@ namespace ParserTools
             return std::numeric_limits<IntT>::max();
         }
 
-        template <typename T, T Base>
-        constexpr T max_preceding_value_negative()
+        /**
+         * @brief Returns true if all eight bytes in @a chunk are decimal
+         *  digits.
+         */
+        constexpr bool is_eight_decimal_digits(uint64_t chunk)
         {
-            if constexpr (std::is_signed<T>::value)
-            {
-                using U = typename std::make_unsigned<T>::type;
-                return T((U(1) << (sizeof(T) * 8 - 1)) / U(Base));
-            }
-            else
-            {
-                return T(0);
-            }
+            return ((chunk & 0xF0F0F0F0F0F0F0F0u)
+                    | (((chunk + 0x0606060606060606u) & 0xF0F0F0F0F0F0F0F0u) >> 4))
+                   == 0x3333333333333333u;
         }
 
-        template <typename T, T Base>
-        constexpr T max_final_digit_negative()
+        /**
+         * @brief Returns the value of the eight decimal digits in
+         *  @a chunk, where the first digit is in the least significant byte.
+         */
+        constexpr uint32_t parse_eight_decimal_digits(uint64_t chunk)
         {
-            if constexpr (std::is_signed<T>::value)
-            {
-                using U = typename std::make_unsigned<T>::type;
-                return T((U(1) << (sizeof(T) * 8 - 1)) % U(Base));
-            }
-            else
-            {
-                return T(0);
-            }
+            // Combine neighbouring digits into 2-digit values, then
+            // the 2-digit values into 4-digit values, and finally the
+            // 4-digit values into the result.
+            chunk -= 0x3030303030303030u;
+            chunk = chunk * 10 + (chunk >> 8);
+            chunk = ((chunk & 0x000000FF000000FFu) * (100 + (1000000ull << 32))
+                     + ((chunk >> 16) & 0x000000FF000000FFu) * (1 + (10000ull << 32)))
+                    >> 32;
+            return uint32_t(chunk);
         }
 
-        template <typename T, T Base>
-        constexpr T max_preceding_value_positive()
+        /**
+         * @brief Parses the longest prefix of @a str that consists of
+         *  decimal digits and is guaranteed to fit in IntT.
+         *
+         * Eight digits are parsed at a time. Returns the number of
+         * digits that were parsed, their value is stored in @a value.
+         */
+        template <typename IntT>
+        size_t parse_decimal_prefix(std::string_view str, IntT& value)
         {
-            if constexpr (std::is_signed<T>::value)
+            // The digits are accumulated in a uint64_t, which also
+            // limits the number of digits for types wider than 64 bits.
+            constexpr size_t SAFE_DIGITS = std::min(
+                std::numeric_limits<IntT>::digits10,
+                std::numeric_limits<uint64_t>::digits10);
+            const auto max_digits = std::min(str.size(), SAFE_DIGITS);
+            uint64_t result = 0;
+            size_t i = 0;
+            if constexpr (std::endian::native == std::endian::little
+                          && SAFE_DIGITS >= 8)
             {
-                using U = typename std::make_unsigned<T>::type;
-                return T(U(~(U(1) << (sizeof(T) * 8 - 1))) / U(Base));
+                for (; i + 8 <= max_digits; i += 8)
+                {
+                    uint64_t chunk;
+                    std::memcpy(&chunk, str.data() + i, sizeof(chunk));
+                    if (!is_eight_decimal_digits(chunk))
+                        break;
+                    result = result * 100000000u + parse_eight_decimal_digits(chunk);
+                }
             }
-            else
+            for (; i < max_digits; ++i)
             {
-                return T(~T(0)) / Base;
+                auto digit = uint8_t(str[i] - '0');
+                if (digit > 9)
+                    break;
+                result = result * 10 + digit;
             }
+            value = IntT(result);
+            return i;
         }
 
-        template <typename T, T Base>
-        constexpr T max_final_digit_positive()
+        template <typename IntT, unsigned Base, bool Underscores>
+        ParseResult<IntT> parse_integer_digits(std::string_view str,
+                                               size_t start, bool negative)
         {
-            if constexpr (std::is_signed<T>::value)
-            {
-                using U = typename std::make_unsigned<T>::type;
-                return T(U(~(U(1) << (sizeof(T) * 8 - 1))) % U(Base));
-            }
-            else
+            using U = std::make_unsigned_t<IntT>;
+            // The magnitude of the smallest signed value doesn't fit
+            // in IntT, the magnitude is therefore accumulated as unsigned.
+            constexpr auto MAX_POSITIVE = U(std::numeric_limits<IntT>::max());
+            constexpr auto MAX_NEGATIVE = std::is_signed_v<IntT>
+                                          ? U(MAX_POSITIVE + 1u) : U(0);
+            const U limit = negative ? MAX_NEGATIVE : MAX_POSITIVE;
+
+            U value = 0;
+            size_t i = start;
+            if constexpr (Base == 10)
             {
-                return T(~T(0)) % Base;
+                IntT prefix = 0;
+                i += parse_decimal_prefix(str.substr(start), prefix);
+                value = U(prefix);
+                if (value > limit)
+                    return {{}, start, std::errc::result_out_of_range};
             }
-        }
 
-        template <typename IntT, IntT Base>
-        std::optional<IntT> parse_positive_integer_impl(std::string_view str)
-        {
-            if (str.empty())
-                return {};
-            IntT value = from_digit<IntT>(str[0]);
-            if (value >= Base)
-                return {};
-            for (size_t i = 1; i < str.size(); ++i)
+            if (i == start)
             {
-                auto digit = from_digit<IntT>(str[i]);
-                if (digit < Base
-                    && (value < max_preceding_value_positive<IntT, Base>()
-                        || (value == max_preceding_value_positive<IntT, Base>()
-                            && digit <= max_final_digit_positive<IntT, Base>())))
-                {
-                    value *= Base;
-                    value += digit;
-                }
-                else if (str[i] != '_' || i == str.size() - 1
-                         || str[i - 1] == '_')
-                {
-                    return {};
-                }
+                if (i == str.size() || from_digit<U>(str[i]) >= Base)
+                    return {{}, i, std::errc::invalid_argument};
+                value = from_digit<U>(str[i++]);
+                if (value > limit)
+                    return {{}, start, std::errc::result_out_of_range};
             }
-            return value;
-        }
 
-        template <typename IntT, IntT Base>
-        std::optional<IntT> parse_negative_integer_impl(std::string_view str)
-        {
-            if constexpr (std::is_signed<IntT>::value)
+            while (i < str.size())
             {
-                if (str.empty())
-                    return {};
-                IntT value = from_digit<IntT>(str[0]);
-                if (value >= Base)
-                    return {};
-                for (size_t i = 1; i < str.size(); ++i)
+                auto digit = from_digit<U>(str[i]);
+                if (digit >= Base)
                 {
-                    auto digit = from_digit<IntT>(str[i]);
-                    if (digit < Base
-                        && (value < max_preceding_value_negative<IntT, Base>()
-                            || (value == max_preceding_value_negative<IntT, Base>()
-                                && digit <= max_final_digit_negative<IntT, Base>())))
-                    {
-                        value *= Base;
-                        value += digit;
-                    }
-                    else if (str[i] != '_' || i == str.size() - 1
-                             || str[i - 1] == '_')
+                    // Single underscores are allowed between digits.
+                    if (!Underscores || str[i] != '_' || i + 1 == str.size()
+                        || from_digit<U>(str[i + 1]) >= Base)
                     {
-                        return {};
+                        break;
                     }
+                    ++i;
+                    continue;
                 }
-                return IntT(-value);
-            }
-            else
-            {
-                if (str.empty())
-                    return {};
-                for (char c : str)
+
+                if (value > limit / Base
+                    || (value == limit / Base && digit > limit % Base))
                 {
-                    auto digit = from_digit<IntT>(c);
-                    if (digit > 0)
-                        return {};
+                    return {{}, i, std::errc::result_out_of_range};
                 }
-                return IntT(0);
+                value = U(value * Base + digit);
+                ++i;
             }
+
+            return {negative ? IntT(U(U(0) - value)) : IntT(value), i, {}};
         }
+
+        /**
+         * @brief The default grammar without base prefixes.
+         */
+        constexpr NumberGrammar NO_PREFIX_NUMBER_GRAMMAR = {
+            .binary_prefix = false,
+            .octal_prefix = false,
+            .hexadecimal_prefix = false
+        };
     }
 
-    template <typename IntT>
-    std::optional<IntT> parse_integer(std::string_view str, bool detect_base)
+    /**
+     * @brief Parses the integer at the start of @a str, accepting the
+     *  syntax selected by @a Grammar.
+     *
+     * Parsing stops at the first character that can't be part of the
+     * number, like std::from_chars.
+     */
+    template <typename IntT, NumberGrammar Grammar>
+    ParseResult<IntT> parse_integer_prefix(std::string_view str)
     {
         static_assert(std::is_integral<IntT>());
+        constexpr bool UNDERSCORES = Grammar.underscores;
 
-        if (str.empty())
-            return {};
-
-        bool positive = true;
-        if (str[0] == '-')
-        {
-            positive = false;
-            str = str.substr(1);
-        }
-        else if (str[0] == '+')
+        size_t i = 0;
+        bool negative = false;
+        if (!str.empty() && (str[0] == '-' || (Grammar.plus_sign && str[0] == '+')))
         {
-            str = str.substr(1);
+            negative = str[0] == '-';
+            ++i;
         }
 
-        if (str.empty())
-            return {};
+        if (i == str.size())
+            return {{}, i, std::errc::invalid_argument};
 
-        if (str[0] == '0' && str.size() >= 3 && detect_base)
+        if constexpr (Grammar.binary_prefix || Grammar.octal_prefix
+                      || Grammar.hexadecimal_prefix)
         {
-            auto str2 = str.substr(2);
-            switch (uint8_t(str[1]) | 0x20u)
+            if (str[i] == '0' && i + 2 < str.size())
             {
-            case 'b':
-                return positive ? Details::parse_positive_integer_impl<IntT, 2>(str2)
-                                : Details::parse_negative_integer_impl<IntT, 2>(str2);
-            case 'o':
-                return positive ? Details::parse_positive_integer_impl<IntT, 8>(str2)
-                                : Details::parse_negative_integer_impl<IntT, 8>(str2);
-            case 'x':
-                return positive ? Details::parse_positive_integer_impl<IntT, 16>(str2)
-                                : Details::parse_negative_integer_impl<IntT, 16>(str2);
-            default:
-                break;
+                auto next = str[i + 2];
+                switch (uint8_t(str[i + 1]) | 0x20u)
+                {
+                case 'b':
+                    if (Grammar.binary_prefix && Details::from_digit<unsigned>(next) < 2)
+                        return Details::parse_integer_digits<IntT, 2, UNDERSCORES>(str, i + 2, negative);
+                    break;
+                case 'o':
+                    if (Grammar.octal_prefix && Details::from_digit<unsigned>(next) < 8)
+                        return Details::parse_integer_digits<IntT, 8, UNDERSCORES>(str, i + 2, negative);
+                    break;
+                case 'x':
+                    if (Grammar.hexadecimal_prefix && Details::from_digit<unsigned>(next) < 16)
+                        return Details::parse_integer_digits<IntT, 16, UNDERSCORES>(str, i + 2, negative);
+                    break;
+                default:
+                    break;
+                }
             }
         }
-        if ('0' <= str[0] && str[0] <= '9')
+
+        if ('0' <= str[i] && str[i] <= '9')
+            return Details::parse_integer_digits<IntT, 10, UNDERSCORES>(str, i, negative);
+
+        auto word = str.substr(i);
+        if constexpr (Grammar.boolean_keywords)
+        {
+            if (word.starts_with("false"))
+                return {IntT(0), i + 5, {}};
+            if (word.starts_with("true"))
+                return {IntT(1), i + 4, {}};
+        }
+        if constexpr (Grammar.null_keyword)
         {
-            return positive ? Details::parse_positive_integer_impl<IntT, 10>(str)
-                            : Details::parse_negative_integer_impl<IntT, 10>(str);
+            if (word.starts_with("null"))
+                return {IntT(0), i + 4, {}};
         }
-        if (str == "false" || str == "null")
-            return IntT(0);
-        if (str == "true")
-            return IntT(1);
-        return {};
+        return {{}, i, std::errc::invalid_argument};
+    }
+
+    /**
+     * @brief Parses the integer at the start of @a str.
+     *
+     * Parsing stops at the first character that can't be part of the
+     * number, like std::from_chars. Digits can be separated by single
+     * underscores, "false", "null" and "true" are parsed as 0, 0 and 1,
+     * and "0x", "0o" and "0b" prefixes are recognized if
+     * @a detect_base is true.
+     */
+    template <typename IntT>
+    ParseResult<IntT> parse_integer_prefix(std::string_view str,
+                                           bool detect_base = false)
+    {
+        if (detect_base)
+            return parse_integer_prefix<IntT, DEFAULT_NUMBER_GRAMMAR>(str);
+        return parse_integer_prefix<IntT, Details::NO_PREFIX_NUMBER_GRAMMAR>(str);
+    }
+
+    /**
+     * @brief Parses an integer, accepting the syntax selected by
+     *  @a Grammar.
+     */
+    template <typename IntT, NumberGrammar Grammar>
+    std::optional<IntT> parse_integer(std::string_view str)
+    {
+        auto result = parse_integer_prefix<IntT, Grammar>(str);
+        if (!result || result.size != str.size())
+            return {};
+        return result.value;
+    }
+
+    template <typename IntT>
+    std::optional<IntT> parse_integer(std::string_view str, bool detect_base)
+    {
+        auto result = parse_integer_prefix<IntT>(str, detect_base);
+        if (!result || result.size != str.size())
+            return {};
+        return result.value;
     }
 }
@@ -0,0 +1,141 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include "ParseFloatingPoint.hpp"
+#include "ParseInteger.hpp"
+#include "StringTokenizer.hpp"
+
+/**
+ * @file
+ * @brief Functions that parse delimited lists of numbers into arrays.
+ */
+
+namespace ParserTools
+{
+    /**
+     * @brief Returns the number of 64-bit words needed for a validity
+     *  bitmap with @a count bits.
+     */
+    constexpr size_t get_validity_bitmap_size(size_t count)
+    {
+        return (count + 63) / 64;
+    }
+
+    /**
+     * @brief Returns true if bit @a index is set in @a bitmap.
+     */
+    constexpr bool is_valid(std::span<const uint64_t> bitmap, size_t index)
+    {
+        return (bitmap[index / 64] >> (index % 64)) & 1u;
+    }
+
+    namespace Details
+    {
+        template <typename T, typename ParseFunc, typename FindDelimiterFunc>
+        SplitResult parse_numbers(std::string_view str,
+                                  FindDelimiterFunc& find_delimiter_func,
+                                  std::span<T> values,
+                                  std::span<uint64_t> valid_bits,
+                                  ParseFunc parse)
+        {
+            if (valid_bits.size() < get_validity_bitmap_size(values.size()))
+                throw std::invalid_argument("The validity bitmap is too small.");
+            std::fill(valid_bits.begin(),
+                      valid_bits.begin() + ptrdiff_t(get_validity_bitmap_size(values.size())),
+                      uint64_t(0));
+
+            size_t count = 0;
+            size_t pos = 0;
+            while (true)
+            {
+                if (count == values.size())
+                    return {count, true};
+
+                // Parse the number first, the delimiter should then
+                // immediately follow it.
+                auto field = str.substr(pos);
+                auto parsed = parse(field);
+                auto [s, e] = find_delimiter_func(field.substr(parsed.size));
+                s += parsed.size;
+                e += parsed.size;
+                if (parsed && s == parsed.size)
+                {
+                    values[count] = parsed.value;
+                    valid_bits[count / 64] |= uint64_t(1) << (count % 64);
+                }
+                else
+                {
+                    values[count] = T();
+                }
+                ++count;
+
+                // No delimiter, this was the last field.
+                if (s == e)
+                    return {count, false};
+
+                // A delimiter at the end is followed by an empty field.
+                pos += e;
+                if (pos == str.size())
+                {
+                    if (count == values.size())
+                        return {count, true};
+                    values[count++] = T();
+                    return {count, false};
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Parses the integers in @a str, separated by the delimiters
+     *  found by @a find_delimiter_func, into @a values.
+     *
+     * The fields are the same as those returned by split(). Each number
+     * is parsed with parse_integer_prefix and the delimiter must follow
+     * immediately after it, so the delimiters can't contain characters
+     * that can be part of a number. Bit i in @a valid_bits is set if
+     * field i is a valid number, otherwise values[i] is 0.
+     * @a valid_bits must have room for at least
+     * get_validity_bitmap_size(values.size()) words.
+     *
+     * If there are more fields than there is room for in @a values,
+     * the overflow flag of the result is set.
+     */
+    template <typename IntT, NumberGrammar Grammar = DEFAULT_NUMBER_GRAMMAR,
+              typename FindDelimiterFunc>
+    SplitResult parse_integers(std::string_view str,
+                               FindDelimiterFunc find_delimiter_func,
+                               std::span<IntT> values,
+                               std::span<uint64_t> valid_bits)
+    {
+        return Details::parse_numbers(str, find_delimiter_func, values, valid_bits,
+                                      parse_integer_prefix<IntT, Grammar>);
+    }
+
+    /**
+     * @brief Parses the floating point numbers in @a str, separated by
+     *  the delimiters found by @a find_delimiter_func, into @a values.
+     *
+     * Works like parse_integers(), invalid fields are set to 0.
+     */
+    template <typename T, NumberGrammar Grammar = DEFAULT_NUMBER_GRAMMAR,
+              typename FindDelimiterFunc>
+    SplitResult parse_floats(std::string_view str,
+                             FindDelimiterFunc find_delimiter_func,
+                             std::span<T> values,
+                             std::span<uint64_t> valid_bits)
+    {
+        return Details::parse_numbers(str, find_delimiter_func, values, valid_bits,
+                                      parse_floating_point_prefix<T, Grammar>);
+    }
+}
@@ -0,0 +1,36 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <cstddef>
+#include <system_error>
+
+namespace ParserTools
+{
+    /**
+     * @brief The result of parsing a value at the start of a string.
+     *
+     * On success, @a size is the number of characters that make up the
+     * value. On failure, @a value is default-constructed and @a size is
+     * the position of the character where parsing failed. @a error is
+     * std::errc::invalid_argument if the string doesn't start with a
+     * value, and std::errc::result_out_of_range if the value doesn't fit
+     * in T.
+     */
+    template <typename T>
+    struct ParseResult
+    {
+        T value = {};
+        size_t size = 0;
+        std::errc error = {};
+
+        explicit constexpr operator bool() const
+        {
+            return error == std::errc();
+        }
+    };
+}
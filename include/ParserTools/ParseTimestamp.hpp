@@ -0,0 +1,357 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string_view>
+#include "ParseDecimal.hpp"
+
+/**
+ * @file
+ * @brief Functions that parse ISO-8601 timestamps.
+ */
+
+namespace ParserTools
+{
+    /**
+     * @brief A broken-down ISO-8601 timestamp.
+     */
+    struct Timestamp
+    {
+        int year = 1970;
+        unsigned month = 1;
+        unsigned day = 1;
+        unsigned hour = 0;
+        unsigned minute = 0;
+        unsigned second = 0;
+        unsigned nanosecond = 0;
+        /**
+         * @brief The offset from UTC in minutes, e.g. 90 for "+01:30".
+         */
+        int utc_offset = 0;
+        /**
+         * @brief True if the timestamp ended with "Z" or an offset.
+         */
+        bool has_utc_offset = false;
+    };
+
+    namespace Details
+    {
+        constexpr bool is_leap_year(int year)
+        {
+            return year % 4 == 0 && (year % 100 != 0 || year % 400 == 0);
+        }
+
+        constexpr unsigned get_days_in_month(int year, unsigned month)
+        {
+            constexpr uint8_t DAYS[] = {31, 28, 31, 30, 31, 30,
+                                        31, 31, 30, 31, 30, 31};
+            return DAYS[month - 1] + (month == 2 && is_leap_year(year));
+        }
+
+        /**
+         * @brief Returns the number of days from 1970-01-01 to the
+         *  given date in the proleptic Gregorian calendar.
+         */
+        constexpr int64_t get_days_since_epoch(int year, unsigned month,
+                                               unsigned day)
+        {
+            // Shift the year to start in March, leap days are then
+            // at the end of the year.
+            year -= month <= 2;
+            const int64_t era = (year >= 0 ? year : year - 399) / 400;
+            const auto year_of_era = unsigned(year - era * 400);
+            const auto day_of_year = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5
+                                     + day - 1;
+            const auto day_of_era = year_of_era * 365 + year_of_era / 4
+                                    - year_of_era / 100 + day_of_year;
+            return era * 146097 + int64_t(day_of_era) - 719468;
+        }
+
+        /**
+         * @brief Checks that the eight bytes in @a chunk are decimal
+         *  digits where @a digit_mask is 0xFF and equal to
+         *  @a separators elsewhere.
+         *
+         * Returns the index of the first byte that doesn't match, or 8
+         * if all of them match.
+         */
+        constexpr unsigned match_digit_pattern(uint64_t chunk,
+                                               uint64_t digit_mask,
+                                               uint64_t separators)
+        {
+            const auto digits = (chunk & digit_mask)
+                                | (0x3030303030303030u & ~digit_mask);
+            const auto mismatch = ((chunk & ~digit_mask) ^ separators)
+                                  | ((digits & 0xF0F0F0F0F0F0F0F0u) ^ 0x3030303030303030u)
+                                  | (((digits + 0x0606060606060606u) & 0xF0F0F0F0F0F0F0F0u)
+                                     ^ 0x3030303030303030u);
+            return unsigned(std::countr_zero(mismatch)) / 8;
+        }
+
+        /**
+         * @brief Replaces each decimal digit in @a chunk with the
+         *  2-digit value starting at that byte.
+         *
+         * Bytes that aren't in @a digit_mask are treated as zeros.
+         */
+        constexpr uint64_t combine_digit_pairs(uint64_t chunk,
+                                               uint64_t digit_mask)
+        {
+            // Mask first, separators below '0' would otherwise borrow
+            // from the following digits.
+            chunk = (chunk & digit_mask) - (0x3030303030303030u & digit_mask);
+            return chunk * 10 + (chunk >> 8);
+        }
+
+        /**
+         * @brief Returns the eight bytes at @a pos in @a str with the
+         *  first byte in the lowest bits, which the masks above assume.
+         */
+        inline uint64_t read_chunk(std::string_view str, size_t pos)
+        {
+            uint64_t chunk = 0;
+            if constexpr (std::endian::native == std::endian::little)
+            {
+                std::memcpy(&chunk, str.data() + pos, sizeof(chunk));
+            }
+            else
+            {
+                for (size_t i = 0; i < sizeof(chunk); ++i)
+                    chunk |= uint64_t(uint8_t(str[pos + i])) << (8 * i);
+            }
+            return chunk;
+        }
+
+        inline bool is_two_digits(std::string_view str, size_t pos)
+        {
+            return pos + 2 <= str.size()
+                   && uint8_t(str[pos] - '0') <= 9
+                   && uint8_t(str[pos + 1] - '0') <= 9;
+        }
+
+        inline unsigned get_two_digits(std::string_view str, size_t pos)
+        {
+            return unsigned(str[pos] - '0') * 10 + unsigned(str[pos + 1] - '0');
+        }
+    }
+
+    /**
+     * @brief Parses the ISO-8601 timestamp at the start of @a str.
+     *
+     * Accepts "YYYY-MM-DD", optionally followed by 'T', 't' or a space
+     * and "hh:mm:ss". The seconds can be followed by '.' or ',' and any
+     * number of fraction digits, digits beyond nanoseconds are ignored.
+     * Finally there can be a 'Z' or an offset like "+01:00", "-0130"
+     * or "+05".
+     *
+     * The date and time are validated, but leap seconds and 24:00:00
+     * are rejected. On error, @a size is the position of the first
+     * invalid character or field.
+     */
+    inline ParseResult<Timestamp> parse_timestamp_prefix(std::string_view str)
+    {
+        using namespace Details;
+        constexpr uint64_t DATE_MASK = 0x00FFFF00FFFFFFFFu;
+        constexpr uint64_t DATE_SEPARATORS = 0x2D00002D00000000u; // "----YY--"
+        constexpr uint64_t TIME_MASK = 0xFFFF00FFFF00FFFFu;
+        constexpr uint64_t TIME_SEPARATORS = 0x00003A00003A0000u; // "--:--:--"
+
+        ParseResult<Timestamp> result;
+        auto& ts = result.value;
+
+        // "YYYY-MM-DD"
+        if (str.size() < 10)
+        {
+            size_t i = 0;
+            while (i < str.size() && (i == 4 || i == 7 ? str[i] == '-'
+                                                       : uint8_t(str[i] - '0') <= 9))
+            {
+                ++i;
+            }
+            return {{}, i, std::errc::invalid_argument};
+        }
+
+        auto chunk = read_chunk(str, 0);
+        if (auto i = match_digit_pattern(chunk, DATE_MASK, DATE_SEPARATORS); i != 8)
+            return {{}, i, std::errc::invalid_argument};
+        if (!is_two_digits(str, 8))
+            return {{}, uint8_t(str[8] - '0') <= 9 ? 9u : 8u, std::errc::invalid_argument};
+        chunk = combine_digit_pairs(chunk, DATE_MASK);
+        ts.year = int((chunk & 0xFF) * 100 + ((chunk >> 16) & 0xFF));
+        ts.month = unsigned(chunk >> 40) & 0xFF;
+        ts.day = get_two_digits(str, 8);
+        if (ts.month < 1 || ts.month > 12)
+            return {{}, 5, std::errc::invalid_argument};
+        if (ts.day < 1 || ts.day > get_days_in_month(ts.year, ts.month))
+            return {{}, 8, std::errc::invalid_argument};
+
+        // "Thh:mm:ss". A space is only a separator if a time follows.
+        size_t i = 10;
+        if (i == str.size()
+            || (str[i] != 'T' && str[i] != 't' && str[i] != ' '))
+        {
+            result.size = i;
+            return result;
+        }
+        if (str.size() < 19
+            || match_digit_pattern(read_chunk(str, 11), TIME_MASK, TIME_SEPARATORS) != 8)
+        {
+            if (str[i] == ' ')
+            {
+                result.size = i;
+                return result;
+            }
+            auto j = str.size() < 19
+                     ? i + 1
+                     : i + 1 + match_digit_pattern(read_chunk(str, 11),
+                                                   TIME_MASK, TIME_SEPARATORS);
+            return {{}, j, std::errc::invalid_argument};
+        }
+        chunk = combine_digit_pairs(read_chunk(str, 11), TIME_MASK);
+        ts.hour = unsigned(chunk) & 0xFF;
+        ts.minute = unsigned(chunk >> 24) & 0xFF;
+        ts.second = unsigned(chunk >> 48) & 0xFF;
+        if (ts.hour > 23)
+            return {{}, 11, std::errc::invalid_argument};
+        if (ts.minute > 59)
+            return {{}, 14, std::errc::invalid_argument};
+        if (ts.second > 59)
+            return {{}, 17, std::errc::invalid_argument};
+        i = 19;
+
+        // The fraction
+        if (i + 1 < str.size() && (str[i] == '.' || str[i] == ',')
+            && uint8_t(str[i + 1] - '0') <= 9)
+        {
+            ++i;
+            uint32_t nanosecond = 0;
+            auto digits = Details::parse_decimal_prefix(str.substr(i, 9), nanosecond);
+            ts.nanosecond = unsigned(nanosecond * DECIMAL_POWERS_OF_TEN[9 - digits]);
+            i += digits;
+            while (i < str.size() && uint8_t(str[i] - '0') <= 9)
+                ++i;
+        }
+
+        // The UTC offset
+        if (i < str.size() && (str[i] == 'Z' || str[i] == 'z'))
+        {
+            ts.has_utc_offset = true;
+            ++i;
+        }
+        else if (i < str.size() && (str[i] == '+' || str[i] == '-')
+                 && is_two_digits(str, i + 1))
+        {
+            const auto sign_pos = i;
+            const auto hours = get_two_digits(str, i + 1);
+            unsigned minutes = 0;
+            i += 3;
+            if (i < str.size() && str[i] == ':' && is_two_digits(str, i + 1))
+            {
+                minutes = get_two_digits(str, i + 1);
+                i += 3;
+            }
+            else if (is_two_digits(str, i))
+            {
+                minutes = get_two_digits(str, i);
+                i += 2;
+            }
+            if (hours > 23 || minutes > 59)
+                return {{}, sign_pos + 1, std::errc::invalid_argument};
+            ts.utc_offset = int(hours * 60 + minutes);
+            if (str[sign_pos] == '-')
+                ts.utc_offset = -ts.utc_offset;
+            ts.has_utc_offset = true;
+        }
+
+        result.size = i;
+        return result;
+    }
+
+    /**
+     * @brief Parses @a str as an ISO-8601 timestamp.
+     *
+     * See parse_timestamp_prefix for the accepted syntax.
+     */
+    inline std::optional<Timestamp> parse_timestamp(std::string_view str)
+    {
+        auto result = parse_timestamp_prefix(str);
+        if (!result || result.size != str.size())
+            return {};
+        return result.value;
+    }
+
+    /**
+     * @brief Returns the number of nanoseconds since
+     *  1970-01-01T00:00:00Z.
+     *
+     * Timestamps without a UTC offset are treated as UTC. Returns
+     * nothing if the result doesn't fit in 64 bits, i.e. for
+     * timestamps before 1677 or after 2262.
+     */
+    constexpr std::optional<int64_t>
+    to_epoch_nanoseconds(const Timestamp& timestamp)
+    {
+        constexpr int64_t NS_PER_SECOND = 1000000000;
+        constexpr int64_t MAX_SECONDS = INT64_MAX / NS_PER_SECOND;
+        constexpr int64_t MIN_SECONDS = INT64_MIN / NS_PER_SECOND - 1;
+
+        const auto days = Details::get_days_since_epoch(timestamp.year,
+                                                        timestamp.month,
+                                                        timestamp.day);
+        const auto seconds = days * 86400
+                             + int64_t(timestamp.hour) * 3600
+                             + (int64_t(timestamp.minute) - timestamp.utc_offset) * 60
+                             + int64_t(timestamp.second);
+        const auto nanosecond = int64_t(timestamp.nanosecond);
+        if (seconds > MAX_SECONDS || seconds < MIN_SECONDS
+            || (seconds == MAX_SECONDS
+                && nanosecond > INT64_MAX % NS_PER_SECOND)
+            || (seconds == MIN_SECONDS
+                && nanosecond < NS_PER_SECOND + INT64_MIN % NS_PER_SECOND))
+        {
+            return {};
+        }
+        // seconds * NS_PER_SECOND alone overflows for MIN_SECONDS.
+        if (seconds < 0)
+            return (seconds + 1) * NS_PER_SECOND + (nanosecond - NS_PER_SECOND);
+        return seconds * NS_PER_SECOND + nanosecond;
+    }
+
+    /**
+     * @brief Parses the ISO-8601 timestamp at the start of @a str and
+     *  returns it as nanoseconds since 1970-01-01T00:00:00Z.
+     *
+     * The error is std::errc::result_out_of_range if the timestamp
+     * is valid, but can't be represented.
+     */
+    inline ParseResult<int64_t> parse_epoch_nanoseconds_prefix(std::string_view str)
+    {
+        auto result = parse_timestamp_prefix(str);
+        if (!result)
+            return {{}, result.size, result.error};
+        auto ns = to_epoch_nanoseconds(result.value);
+        if (!ns)
+            return {{}, 0, std::errc::result_out_of_range};
+        return {*ns, result.size, {}};
+    }
+
+    /**
+     * @brief Parses @a str as an ISO-8601 timestamp and returns it as
+     *  nanoseconds since 1970-01-01T00:00:00Z.
+     */
+    inline std::optional<int64_t> parse_epoch_nanoseconds(std::string_view str)
+    {
+        auto result = parse_epoch_nanoseconds_prefix(str);
+        if (!result || result.size != str.size())
+            return {};
+        return result.value;
+    }
+}
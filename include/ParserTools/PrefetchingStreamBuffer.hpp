@@ -0,0 +1,97 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <cstddef>
+#include <iosfwd>
+#include <memory>
+#include <string_view>
+
+/**
+ * @file
+ * @brief Defines the PrefetchingStreamBuffer class.
+ */
+
+namespace ParserTools
+{
+    constexpr size_t DEFAULT_PREFETCH_BLOCK_SIZE = 256 * 1024;
+
+    namespace Details
+    {
+        struct PrefetchContext;
+    }
+
+    /**
+     * @brief A stream buffer that reads the next block of the stream on
+     *  a helper thread while the current block is being tokenized.
+     *
+     * The buffer has the same interface as StreamBuffer and can be used
+     * with StreamTokenizer:
+     *
+     *     tokenize(PrefetchingStreamBuffer(&stream), FindNewline())
+     *
+     * The helper thread and the tokenizing thread hand two blocks back
+     * and forth through a lock-free single-producer/single-consumer
+     * queue. Data that hasn't been consumed when the tokenizer moves to
+     * the next block is copied in front of that block's data, so only the
+     * unfinished token is copied. Tokens longer than a block are collected
+     * in an overflow buffer that grows geometrically.
+     *
+     * The stream must not be used by anyone else while the buffer exists.
+     * Exceptions thrown by the stream are rethrown by fill().
+     */
+    class PrefetchingStreamBuffer
+    {
+    public:
+        PrefetchingStreamBuffer();
+
+        explicit PrefetchingStreamBuffer(std::istream* stream,
+                                         size_t block_size = DEFAULT_PREFETCH_BLOCK_SIZE);
+
+        PrefetchingStreamBuffer(PrefetchingStreamBuffer&& other) noexcept;
+
+        PrefetchingStreamBuffer& operator=(PrefetchingStreamBuffer&& other) noexcept;
+
+        /**
+         * @brief Stops the helper thread.
+         *
+         * Waits for the helper thread's current read to complete.
+         */
+        ~PrefetchingStreamBuffer();
+
+        explicit operator bool() const;
+
+        [[nodiscard]]
+        std::string_view string() const
+        {
+            return {data_ + offset_, size_ - offset_};
+        }
+
+        void consume(size_t size)
+        {
+            offset_ += size;
+        }
+
+        bool fill();
+
+        /**
+         * @brief Returns the number of bytes fill() has copied in front
+         *  of a new block or to the overflow buffer.
+         */
+        [[nodiscard]]
+        size_t bytes_moved() const
+        {
+            return bytes_moved_;
+        }
+    private:
+        std::unique_ptr<Details::PrefetchContext> context_;
+        const char* data_ = nullptr;
+        size_t offset_ = 0;
+        size_t size_ = 0;
+        size_t bytes_moved_ = 0;
+    };
+}
@@ -0,0 +1,121 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <algorithm>
+#include <cassert>
+#include <functional>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include "ByteSearch.hpp"
+#include "DelimiterFinders.hpp"
+
+/**
+ * @file
+ * @brief Extraction of selected columns from delimited lines.
+ */
+
+namespace ParserTools
+{
+    namespace Details
+    {
+        inline size_t project_columns(std::string_view str, char delimiter,
+                                      std::span<const size_t> columns,
+                                      std::span<std::string_view> fields)
+        {
+            size_t column = 0;
+            size_t pos = 0;
+            size_t count = 0;
+            for (; count < columns.size(); ++count)
+            {
+                // Jump to the next column without looking at the
+                // columns in between.
+                if (columns[count] != column)
+                {
+                    auto rest = str.substr(pos);
+                    auto skip = find_nth_byte(rest, delimiter,
+                                              columns[count] - column - 1);
+                    if (skip == rest.size())
+                        break;
+                    pos += skip + 1;
+                    column = columns[count];
+                }
+
+                auto rest = str.substr(pos);
+                auto end = find_byte(rest, delimiter);
+                fields[count] = rest.substr(0, end);
+                if (end == rest.size())
+                {
+                    ++count;
+                    break;
+                }
+                pos += end + 1;
+                ++column;
+            }
+            return count;
+        }
+
+        template <typename FindDelimiterFunc>
+        size_t project_columns(std::string_view str,
+                               FindDelimiterFunc& find_delimiter_func,
+                               std::span<const size_t> columns,
+                               std::span<std::string_view> fields)
+        {
+            size_t column = 0;
+            size_t count = 0;
+            while (count < columns.size())
+            {
+                auto [s, e] = find_delimiter_func(str);
+                if (column == columns[count])
+                    fields[count++] = str.substr(0, s);
+                if (s == e)
+                    break;
+                str = str.substr(e);
+                ++column;
+            }
+            return count;
+        }
+    }
+
+    /**
+     * @brief Writes the columns of @a str whose indices are in
+     *  @a columns to @a fields, and returns the number of columns that
+     *  were found.
+     *
+     * @a columns must be sorted in increasing order without
+     * duplicates, and @a fields must be at least as large as
+     * @a columns. The columns are the same as the parts returned by
+     * split(). If @a str has fewer columns than requested, the return
+     * value is less than columns.size().
+     *
+     * The search stops after the last requested column. With FindChar
+     * the columns that aren't requested are skipped by counting
+     * delimiters with find_nth_byte, other finders are called once per
+     * column up to the last requested one.
+     */
+    template <typename FindDelimiterFunc>
+    size_t project_columns(std::string_view str,
+                           FindDelimiterFunc find_delimiter_func,
+                           std::span<const size_t> columns,
+                           std::span<std::string_view> fields)
+    {
+        assert(fields.size() >= columns.size());
+        assert(std::adjacent_find(columns.begin(), columns.end(),
+                                  std::greater_equal<>()) == columns.end());
+        if constexpr (std::is_same_v<FindDelimiterFunc, FindChar>)
+        {
+            return Details::project_columns(str, find_delimiter_func.character(),
+                                            columns, fields);
+        }
+        else
+        {
+            return Details::project_columns(str, find_delimiter_func,
+                                            columns, fields);
+        }
+    }
+}
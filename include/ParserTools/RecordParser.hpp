@@ -0,0 +1,204 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <algorithm>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include "ParseFloatingPoint.hpp"
+#include "ParseInteger.hpp"
+#include "StringTokenizer.hpp"
+
+/**
+ * @file
+ * @brief Parsing of delimited records directly into structs.
+ *
+ * A record parser is declared with the struct and a list of fields:
+ *
+ *     struct Trade
+ *     {
+ *         int64_t id;
+ *         std::string_view symbol;
+ *         double price;
+ *     };
+ *
+ *     using TradeParser = RecordParser<Trade,
+ *         RecordField<0, &Trade::id>,
+ *         RecordField<2, &Trade::symbol>,
+ *         RecordField<3, &Trade::price>>;
+ *
+ *     auto trade = TradeParser::parse(line, FindChar(','));
+ */
+
+namespace ParserTools
+{
+    namespace Details
+    {
+        template <typename T>
+        struct MemberPointerTraits;
+
+        template <typename Class, typename T>
+        struct MemberPointerTraits<T Class::*>
+        {
+            using ClassType = Class;
+            using MemberType = T;
+        };
+
+        /**
+         * @brief Marks a field that is parsed by parse_record_field.
+         */
+        struct DefaultFieldParser
+        {};
+
+        /**
+         * @brief Parses @a str as a value of type T, the default for
+         *  record fields.
+         */
+        template <typename T>
+        std::optional<T> parse_record_field(std::string_view str)
+        {
+            if constexpr (std::is_same_v<T, std::string_view>
+                          || std::is_same_v<T, std::string>)
+            {
+                return T(str);
+            }
+            else if constexpr (std::is_floating_point_v<T>)
+            {
+                return parse_floating_point<T>(str);
+            }
+            else
+            {
+                static_assert(std::is_integral_v<T> && !std::is_same_v<T, bool>,
+                              "There is no default parser for this type.");
+                return parse_integer<T>(str, false);
+            }
+        }
+    }
+
+    /**
+     * @brief Binds column number @a Column to the data member @a Member.
+     *
+     * @a Parser is called with the column's text and must return
+     * something that converts to bool (false if the text is invalid)
+     * and can be dereferenced to get the value, such as std::optional.
+     * By default, integers and floating point numbers are parsed with
+     * parse_integer and parse_floating_point, and std::string and
+     * std::string_view members get the text as it is.
+     */
+    template <size_t Column, auto Member,
+              auto Parser = Details::DefaultFieldParser{}>
+    struct RecordField
+    {
+        static_assert(std::is_member_object_pointer_v<decltype(Member)>);
+
+        using RecordType = typename Details::MemberPointerTraits<decltype(Member)>::ClassType;
+        using ValueType = typename Details::MemberPointerTraits<decltype(Member)>::MemberType;
+
+        static constexpr size_t COLUMN = Column;
+
+        /**
+         * @brief Parses @a str and assigns the value to the member
+         *  in @a record.
+         */
+        static bool parse(std::string_view str, RecordType& record)
+        {
+            if constexpr (std::is_same_v<std::remove_cv_t<decltype(Parser)>,
+                                         Details::DefaultFieldParser>)
+            {
+                auto value = Details::parse_record_field<ValueType>(str);
+                if (!value)
+                    return false;
+                record.*Member = std::move(*value);
+            }
+            else
+            {
+                auto value = Parser(str);
+                if (!value)
+                    return false;
+                record.*Member = std::move(*value);
+            }
+            return true;
+        }
+    };
+
+    /**
+     * @brief Parses delimited records into instances of @a Record.
+     *
+     * The columns are visited once, in order. Columns that aren't
+     * bound to a member are skipped without being converted, and the
+     * columns after the last bound column aren't searched at all. The
+     * same column can be bound to several members.
+     */
+    template <typename Record, typename... Fields>
+    class RecordParser
+    {
+    public:
+        static_assert(sizeof...(Fields) != 0);
+        static_assert((std::is_same_v<typename Fields::RecordType, Record> && ...),
+                      "The fields must be members of Record.");
+
+        /**
+         * @brief The number of columns a record must have at least.
+         */
+        static constexpr size_t COLUMN_COUNT = std::max({Fields::COLUMN...}) + 1;
+
+        /**
+         * @brief Assigns the bound columns in @a str to the members of
+         *  @a record.
+         *
+         * Returns false if @a str has less than COLUMN_COUNT columns or
+         * one of the columns can't be parsed. @a record can then be
+         * partially updated.
+         */
+        template <typename FindDelimiterFunc>
+        static bool parse(std::string_view str,
+                          FindDelimiterFunc find_delimiter_func,
+                          Record& record)
+        {
+            size_t column = 0;
+            for (auto item : tokenize(str, std::move(find_delimiter_func)))
+            {
+                if (!parse_column(column, item.string(), record))
+                    return false;
+                if (++column == COLUMN_COUNT)
+                    return true;
+                // Without a delimiter this was the last column.
+                if (item.token().empty())
+                    break;
+                // A delimiter at the end is followed by an empty column.
+                if (item.remainder().empty())
+                {
+                    return parse_column(column, {}, record)
+                           && ++column == COLUMN_COUNT;
+                }
+            }
+            return false;
+        }
+
+        /**
+         * @brief Returns a Record with the bound columns in @a str, or
+         *  nothing if the record is invalid.
+         */
+        template <typename FindDelimiterFunc>
+        static std::optional<Record> parse(std::string_view str,
+                                           FindDelimiterFunc find_delimiter_func)
+        {
+            Record record{};
+            if (!parse(str, std::move(find_delimiter_func), record))
+                return {};
+            return record;
+        }
+    private:
+        static bool parse_column(size_t column, std::string_view str,
+                                 Record& record)
+        {
+            return ((column != Fields::COLUMN || Fields::parse(str, record)) && ...);
+        }
+    };
+}
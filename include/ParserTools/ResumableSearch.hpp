@@ -0,0 +1,128 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <string_view>
+#include <utility>
+
+/**
+ * @file
+ * @brief The optional protocols that let the stream tokenizers resume
+ *  a delimiter search after reading more data, and deliver tokens
+ *  without reading more data.
+ */
+
+namespace ParserTools
+{
+    /**
+     * @brief A delimiter finder that can tell where a search can resume
+     *  when more bytes are appended to the string it searched.
+     *
+     * When the finder doesn't find a complete delimiter, the stream
+     * tokenizers read more data and search again.
+     * resume_position(str, delimiter_start) receives the string and the
+     * start of the delimiter from the previous search, and returns the
+     * position in str where the next search can start. No delimiter
+     * (or longer version of the current delimiter) can start before that
+     * position, regardless of which bytes are appended.
+     *
+     * resume_position is called before the tokenizers read more data,
+     * str is therefore still valid and can be inspected by the
+     * function. The returned position is applied to the string after
+     * the new bytes have been appended.
+     *
+     * Finders that don't implement the function are searched from the
+     * start of the string every time.
+     */
+    template <typename FindDelimiterFunc>
+    concept ResumableDelimiterFinder = requires(const FindDelimiterFunc& f,
+                                                std::string_view str,
+                                                size_t pos)
+    {
+        { f.resume_position(str, pos) } -> std::convertible_to<size_t>;
+    };
+
+    /**
+     * @brief A delimiter finder that can tell if a delimiter near the end
+     *  of a string is complete.
+     *
+     * is_complete_delimiter(str, start, end) is called for every
+     * delimiter the finder returns, i.e. when start is less than end.
+     * It returns true if the delimiter can't be extended or replaced by a
+     * longer delimiter when more bytes are appended to str. The stream
+     * tokenizers then deliver the token at once, otherwise they read
+     * more data and search again.
+     *
+     * Finders that don't implement the function wait for more data when
+     * the delimiter ends at the end of the string, and only then.
+     */
+    template <typename FindDelimiterFunc>
+    concept CompletableDelimiterFinder = requires(const FindDelimiterFunc& f,
+                                                  std::string_view str,
+                                                  size_t pos)
+    {
+        { f.is_complete_delimiter(str, pos, pos) } -> std::convertible_to<bool>;
+    };
+
+    namespace Details
+    {
+        template <typename FindDelimiterFunc>
+        bool is_complete_delimiter(const FindDelimiterFunc& find_func,
+                                   std::string_view str,
+                                   size_t delimiter_start,
+                                   size_t delimiter_end)
+        {
+            if constexpr (CompletableDelimiterFinder<FindDelimiterFunc>)
+                return find_func.is_complete_delimiter(str, delimiter_start,
+                                                       delimiter_end);
+            else
+                return delimiter_end != str.size();
+        }
+
+        template <typename FindDelimiterFunc>
+        size_t get_resume_position(const FindDelimiterFunc& find_func,
+                                   std::string_view str,
+                                   size_t delimiter_start)
+        {
+            if constexpr (ResumableDelimiterFinder<FindDelimiterFunc>)
+                return find_func.resume_position(str, delimiter_start);
+            else
+                return 0;
+        }
+
+        /**
+         * @brief Returns the resume position for a finder whose delimiters
+         *  start with a sequence of at most @a max_length bytes that
+         *  must be seen in full before the delimiter is recognized.
+         */
+        constexpr size_t get_resume_position(std::string_view str,
+                                             size_t delimiter_start,
+                                             size_t max_length)
+        {
+            if (max_length <= 1)
+                return delimiter_start;
+            auto tail = std::min(str.size(), max_length - 1);
+            return std::min(delimiter_start, str.size() - tail);
+        }
+
+        /**
+         * @brief Calls @a find_func on the part of @a str that starts
+         *  at @a pos and returns the delimiter's position in @a str.
+         */
+        template <typename FindDelimiterFunc>
+        std::pair<size_t, size_t> find_delimiter_from(FindDelimiterFunc& find_func,
+                                                      std::string_view str,
+                                                      size_t pos)
+        {
+            auto [s, e] = find_func(str.substr(pos));
+            return {s + pos, e + pos};
+        }
+    }
+}
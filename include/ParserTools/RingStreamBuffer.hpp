@@ -0,0 +1,108 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <memory>
+#include "StreamTokenizer.hpp"
+
+/**
+ * @file
+ * @brief Defines the RingStreamBuffer class.
+ */
+
+namespace ParserTools
+{
+    namespace Details
+    {
+        struct RingBufferContext;
+    }
+
+    /**
+     * @brief A stream buffer that never moves unconsumed data to make room
+     *  for more.
+     *
+     * The buffer is a ring whose memory pages are mapped twice, back to
+     * back, so data that wraps around the end of the ring is still
+     * contiguous in memory. fill() reads into the free part of the ring
+     * regardless of where the unconsumed data starts. Data is only copied
+     * when a single token is larger than the ring, in which case the ring
+     * is replaced by one twice the size.
+     *
+     * The buffer has the same interface as StreamBuffer and can be used
+     * with StreamTokenizer:
+     *
+     *     tokenize(RingStreamBuffer(&stream), FindNewline())
+     *
+     * The capacity is rounded up to a multiple of the page size (the
+     * allocation granularity on Windows). Throws std::system_error if the
+     * memory can't be mapped.
+     */
+    class RingStreamBuffer
+    {
+    public:
+        RingStreamBuffer();
+
+        explicit RingStreamBuffer(std::istream* stream,
+                                  StreamReadMode mode = StreamReadMode::THROUGHPUT,
+                                  size_t capacity = DEFAULT_STREAM_BUFFER_CAPACITY);
+
+        RingStreamBuffer(RingStreamBuffer&& other) noexcept;
+
+        RingStreamBuffer& operator=(RingStreamBuffer&& other) noexcept;
+
+        ~RingStreamBuffer();
+
+        explicit operator bool() const
+        {
+            return stream_ && *stream_;
+        }
+
+        [[nodiscard]]
+        std::string_view string() const
+        {
+            return {data_ + offset_, size_};
+        }
+
+        void consume(size_t size)
+        {
+            offset_ += size;
+            size_ -= size;
+            if (offset_ >= capacity_)
+                offset_ -= capacity_;
+        }
+
+        bool fill();
+
+        /**
+         * @brief Returns the current size of the ring.
+         */
+        [[nodiscard]]
+        size_t capacity() const
+        {
+            return capacity_;
+        }
+
+        /**
+         * @brief Returns the number of bytes fill() has copied to a larger
+         *  ring.
+         */
+        [[nodiscard]]
+        size_t bytes_moved() const
+        {
+            return bytes_moved_;
+        }
+    private:
+        std::istream* stream_ = nullptr;
+        StreamReadMode mode_ = StreamReadMode::THROUGHPUT;
+        std::unique_ptr<Details::RingBufferContext> context_;
+        char* data_ = nullptr;
+        size_t offset_ = 0;
+        size_t size_ = 0;
+        size_t capacity_ = 0;
+        size_t bytes_moved_ = 0;
+    };
+}
@@ -39,6 +39,12 @@ namespace ParserTools
 
         virtual ~ElementHandler() = default;
 
+        /**
+         * @brief Called for each start tag.
+         *
+         * @a attributes is owned by the parser and reused for the next
+         * start tag, it is only valid during the call.
+         */
         virtual void start_element(std::string_view name,
                                    const Attributes& attributes)
         {}
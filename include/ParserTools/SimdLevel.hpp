@@ -0,0 +1,54 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+
+/**
+ * @file
+ * @brief Selection of the instruction sets used by the search functions.
+ */
+
+namespace ParserTools
+{
+    /**
+     * @brief The instruction set levels the vectorized search functions
+     *  can use.
+     *
+     * The levels are ordered, each level implies the ones before it.
+     */
+    enum class SimdLevel
+    {
+        SCALAR,
+        SSE2,
+        AVX2,
+        AVX512
+    };
+
+    /**
+     * @brief Returns the highest level supported by both the CPU and the
+     *  operating system.
+     */
+    [[nodiscard]] SimdLevel detected_simd_level();
+
+    /**
+     * @brief Returns the level currently used by the search functions.
+     *
+     * Initially this is the same as detected_simd_level().
+     */
+    [[nodiscard]] SimdLevel simd_level();
+
+    /**
+     * @brief Sets the level used by the search functions.
+     *
+     * Levels above detected_simd_level() are reduced to that level.
+     * SimdLevel::SCALAR selects the plain C++ implementations, which
+     * makes it possible to cross-check the results of the vectorized ones.
+     *
+     * @return the level that was actually selected.
+     */
+    SimdLevel set_simd_level(SimdLevel level);
+}
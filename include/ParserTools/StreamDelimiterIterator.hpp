@@ -11,6 +11,7 @@
 #include <istream>
 #include <string_view>
 #include <vector>
+#include "ResumableSearch.hpp"
 
 template <typename FindDelimiterFunc>
 class StreamDelimiterIterator
@@ -34,17 +35,24 @@ public:
             return false;
         }
 
+        size_t pos = 0;
         while (true)
         {
-            auto[s, e] = find_delimiter_func_(str_);
-            if ((s != e && e != str_.size()) || !fill_buffer())
+            auto[s, e] = ParserTools::Details::find_delimiter_from(
+                find_delimiter_func_, str_, pos);
+            if (s != e && ParserTools::Details::is_complete_delimiter(
+                              find_delimiter_func_, str_, s, e))
             {
-                assert(e <= str_.size());
-                assert(s <= e);
-                delimiter_start_ = s;
-                delimiter_end = e;
-                return true;
+                return set_delimiter(s, e);
             }
+            // The resume position must be computed from the string that
+            // was searched, fill_buffer() appends to it. Positions in
+            // str_ remain the same when fill_buffer() moves the data.
+            auto resume_pos = ParserTools::Details::get_resume_position(
+                find_delimiter_func_, str_, s);
+            if (!fill_buffer())
+                return set_delimiter(s, e);
+            pos = resume_pos;
         }
     }
 
@@ -66,23 +74,48 @@ public:
     {
         return str_.substr(delimiter_end);
     }
+
+    /**
+     * @brief Returns the number of bytes that have been copied to make
+     *  room for more data in the buffer.
+     */
+    [[nodiscard]]
+    size_t bytes_moved() const
+    {
+        return bytes_moved_;
+    }
 private:
+    bool set_delimiter(size_t start, size_t end)
+    {
+        assert(end <= str_.size());
+        assert(start <= end);
+        delimiter_start_ = start;
+        delimiter_end = end;
+        return true;
+    }
+
     bool fill_buffer()
     {
         if (!stream_ || !*stream_)
             return false;
 
-        if (delimiter_end != 0)
+        // str_ always ends at the end of the buffer, but it has moved
+        // past all the previous delimiters, not just the last one.
+        auto offset = str_.data() ? size_t(str_.data() - buffer_.data()) : 0;
+        if (offset != 0)
         {
-            std::copy(buffer_.begin() + delimiter_end, buffer_.end(),
+            std::copy(buffer_.begin() + offset, buffer_.end(),
                       buffer_.begin());
-            str_ = {buffer_.data(), buffer_.size() - delimiter_end};
+            bytes_moved_ += buffer_.size() - offset;
+            str_ = {buffer_.data(), buffer_.size() - offset};
             delimiter_start_ = delimiter_end = 0;
         }
         else if (str_.size() == buffer_.size())
         {
             auto prev_size = buffer_.size();
-            buffer_.resize(buffer_.size() * 2);
+            if (buffer_.capacity() < prev_size * 2)
+                bytes_moved_ += prev_size;
+            buffer_.resize(prev_size * 2);
             str_ = {buffer_.data(), prev_size};
         }
 
@@ -99,5 +132,6 @@ private:
     size_t delimiter_start_ = 0;
     size_t delimiter_end = 0;
     std::vector<char> buffer_;
+    size_t bytes_moved_ = 0;
     FindDelimiterFunc find_delimiter_func_;
 };
@@ -7,8 +7,14 @@
 //****************************************************************************
 #pragma once
 #include <cassert>
+#include <concepts>
 #include <istream>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
 #include <string_view>
+#include <type_traits>
+#include "ResumableSearch.hpp"
 
 namespace ParserTools
 {
@@ -67,40 +73,102 @@ namespace ParserTools
 
     constexpr size_t DEFAULT_STREAM_BUFFER_CAPACITY = 64 * 1024;
 
+    enum class StreamReadMode
+    {
+        /**
+         * @brief fill() reads until the buffer is full or the stream ends.
+         */
+        THROUGHPUT,
+        /**
+         * @brief fill() returns as soon as some bytes are available.
+         *
+         * Use this mode for pipes and sockets where data arrives a little
+         * at a time, and each token should be delivered as soon as it is
+         * complete. Note that std::cin only delivers one byte per read
+         * unless std::ios::sync_with_stdio(false) has been called.
+         */
+        LATENCY
+    };
+
+    namespace Details
+    {
+        inline size_t read_available(std::istream& stream,
+                                     char* buffer, size_t size)
+        {
+            auto count = stream.readsome(buffer, std::streamsize(size));
+            if (count == 0)
+            {
+                // Nothing is buffered. Block until a single byte arrives,
+                // then take whatever arrived along with it.
+                if (!stream.get(*buffer))
+                    return 0;
+                count = 1 + stream.readsome(buffer + 1,
+                                            std::streamsize(size - 1));
+            }
+            return size_t(count);
+        }
+
+        /**
+         * @brief Reads at most @a size bytes from @a stream into @a buffer
+         *  and returns the number of bytes read.
+         */
+        inline size_t read_stream(std::istream& stream, StreamReadMode mode,
+                                  char* buffer, size_t size)
+        {
+            if (mode == StreamReadMode::LATENCY)
+                return read_available(stream, buffer, size);
+            stream.read(buffer, std::streamsize(size));
+            return size_t(stream.gcount());
+        }
+    }
+
     class StreamBuffer
     {
     public:
         constexpr StreamBuffer() = default;
 
-        explicit constexpr StreamBuffer(std::istream* stream)
-            : stream_(stream)
+        explicit constexpr StreamBuffer(std::istream* stream,
+                                        StreamReadMode mode = StreamReadMode::THROUGHPUT)
+            : stream_(stream),
+              mode_(mode)
         {}
 
         StreamBuffer(StreamBuffer&& other) noexcept
             : stream_(other.stream_),
+              mode_(other.mode_),
               buffer_(std::move(other.buffer_)),
               offset_(other.offset_),
               size_(other.size_),
-              capacity_(other.capacity_)
+              capacity_(other.capacity_),
+              bytes_moved_(other.bytes_moved_)
         {
             other.stream_ = nullptr;
             other.offset_ = other.size_ = other.capacity_ = 0;
+            other.bytes_moved_ = 0;
         }
 
         StreamBuffer& operator=(StreamBuffer&& other) noexcept
         {
             stream_ = other.stream_;
+            mode_ = other.mode_;
             buffer_ = std::move(other.buffer_);
             offset_ = other.offset_;
             size_ = other.size_;
             capacity_ = other.capacity_;
+            bytes_moved_ = other.bytes_moved_;
             other.stream_ = nullptr;
             other.offset_ = other.size_ = other.capacity_ = 0;
+            other.bytes_moved_ = 0;
             return *this;
         }
 
+        explicit operator bool() const
+        {
+            return stream_ && *stream_;
+        }
+
         [[nodiscard]]
-        constexpr std::string_view string() const
+        std::string_view string() const
         {
             return {buffer_.get() + offset_, size_ - offset_};
         }
@@ -120,6 +188,7 @@ namespace ParserTools
                 std::copy(buffer_.get() + offset_, buffer_.get() + size_,
                           buffer_.get());
                 size_ -= offset_;
+                bytes_moved_ += size_;
                 offset_ = 0;
             }
             else if (size_ == capacity_)
@@ -128,23 +197,54 @@ namespace ParserTools
                 std::unique_ptr<char[]> buffer(new char[capacity_]);
                 std::copy(buffer_.get(), buffer_.get() + size_, buffer.get());
                 buffer_ = std::move(buffer);
+                bytes_moved_ += size_;
             }
 
-            auto bytes_to_read = std::streamsize(capacity_ - size_);
-            stream_->read(buffer_.get() + size_, bytes_to_read);
-            auto bytes_read = size_t(stream_->gcount());
+            auto bytes_read = Details::read_stream(*stream_, mode_,
+                                                   buffer_.get() + size_,
+                                                   capacity_ - size_);
             size_ += bytes_read;
             return bytes_read != 0;
         }
+
+        /**
+         * @brief Returns the number of bytes fill() has copied within the
+         *  buffer or to a larger buffer.
+         */
+        [[nodiscard]]
+        size_t bytes_moved() const
+        {
+            return bytes_moved_;
+        }
     private:
         std::istream* stream_ = nullptr;
+        StreamReadMode mode_ = StreamReadMode::THROUGHPUT;
         std::unique_ptr<char[]> buffer_;
         size_t offset_ = 0;
         size_t size_ = 0;
         size_t capacity_ = 0;
+        size_t bytes_moved_ = 0;
     };
 
-    template <typename FindDelimiterFunc>
+    /**
+     * @brief The interface StreamTokenizer requires of its buffer.
+     *
+     * string() returns the data that hasn't been consumed yet, consume()
+     * marks the first bytes of string() as used, and fill() makes more
+     * data available, returning false when there is no more data.
+     * Converting the buffer to bool tells if it has a valid source.
+     */
+    template <typename Buffer>
+    concept TokenizerBuffer = std::movable<Buffer>
+        && requires(Buffer& buffer, const Buffer& const_buffer, size_t n)
+        {
+            { const_buffer.string() } -> std::convertible_to<std::string_view>;
+            buffer.consume(n);
+            { buffer.fill() } -> std::convertible_to<bool>;
+            bool(const_buffer);
+        };
+
+    template <typename FindDelimiterFunc, TokenizerBuffer Buffer = StreamBuffer>
     class StreamTokenizerIterator
     {
     public:
@@ -158,10 +258,17 @@ namespace ParserTools
 
         constexpr StreamTokenizerIterator(std::istream& stream,
                                           FindDelimiterFunc find_func)
-            : buffer_(&stream),
+            requires std::is_same_v<Buffer, StreamBuffer>
+            : StreamTokenizerIterator(StreamBuffer(&stream),
+                                      std::move(find_func))
+        {}
+
+        constexpr StreamTokenizerIterator(Buffer&& buffer,
+                                          FindDelimiterFunc find_func)
+            : buffer_(std::move(buffer)),
               find_delimiter_func_(find_func)
         {
-            bool is_first = bool(stream);
+            bool is_first = bool(buffer_);
             operator++();
             is_first_ = is_first;
         }
@@ -178,20 +285,47 @@ namespace ParserTools
 
         StreamTokenizerIterator& operator++()
         {
+            // Where the search starts, after a fill only the new bytes
+            // and the end of the previous search are searched.
+            size_t pos = 0;
             while (true)
             {
-                auto[s, e] = find_delimiter_func_(buffer_.string());
-                if (e != buffer_.string().size() || !buffer_.fill())
+                auto str = buffer_.string();
+                auto[s, e] = Details::find_delimiter_from(find_delimiter_func_,
+                                                          str, pos);
+                if (s == e ? e == str.size()
+                           : !Details::is_complete_delimiter(
+                                 find_delimiter_func_, str, s, e))
                 {
-                    item_ = {{buffer_.string()}, s, e};
-                    buffer_.consume(e);
-                    break;
+                    // fill() can move or free the data str refers to,
+                    // the resume position must be computed first.
+                    auto resume_pos = Details::get_resume_position(
+                        find_delimiter_func_, str, s);
+                    if (buffer_.fill())
+                    {
+                        pos = resume_pos;
+                        continue;
+                    }
+                    str = buffer_.string();
                 }
+                item_ = {str, s, e};
+                buffer_.consume(e);
+                break;
             }
             is_first_ = false;
             return *this;
         }
 
+        /**
+         * @brief Gives access to the buffer, for instance to read its
+         *  statistics.
+         */
+        [[nodiscard]]
+        const Buffer& buffer() const
+        {
+            return buffer_;
+        }
+
         StreamTokenizerIterator operator++(int)
         {
             operator++();
@@ -212,37 +346,44 @@ namespace ParserTools
 
     private:
         StreamTokenizerItem item_;
-        StreamBuffer buffer_;
+        Buffer buffer_;
         FindDelimiterFunc find_delimiter_func_;
         bool is_first_ = false;
     };
 
-    template <typename FindDelimiterFunc>
+    template <typename FindDelimiterFunc, TokenizerBuffer Buffer = StreamBuffer>
     class StreamTokenizer
     {
     public:
         StreamTokenizer(std::istream& stream,
                         FindDelimiterFunc find_delimiter_func)
-            : stream_(&stream),
+            requires std::is_same_v<Buffer, StreamBuffer>
+            : buffer_(&stream),
+              find_delimiter_func(find_delimiter_func)
+        {}
+
+        StreamTokenizer(Buffer buffer,
+                        FindDelimiterFunc find_delimiter_func)
+            : buffer_(std::move(buffer)),
               find_delimiter_func(find_delimiter_func)
         {}
 
-        StreamTokenizerIterator<FindDelimiterFunc> begin()
+        StreamTokenizerIterator<FindDelimiterFunc, Buffer> begin()
         {
-            if (!stream_)
+            if (is_used_)
                 throw std::runtime_error("Can not call begin() more than once.");
-            auto* stream = stream_;
-            stream_ = nullptr;
-            return {*stream, find_delimiter_func};
+            is_used_ = true;
+            return {std::move(buffer_), find_delimiter_func};
         }
 
-        constexpr StreamTokenizerIterator<FindDelimiterFunc> end() const
+        constexpr StreamTokenizerIterator<FindDelimiterFunc, Buffer> end() const
         {
             return {};
         }
     private:
-        std::istream* stream_;
+        Buffer buffer_;
         FindDelimiterFunc find_delimiter_func;
+        bool is_used_ = false;
     };
 
     template <typename FindDelimiterFunc>
@@ -251,4 +392,15 @@ namespace ParserTools
     {
         return {stream, std::move(find_delimiter_func)};
     }
+
+    /**
+     * @brief Returns a tokenizer that takes ownership of @a buffer,
+     *  for instance a MappedFile.
+     */
+    template <typename FindDelimiterFunc, TokenizerBuffer Buffer>
+    constexpr StreamTokenizer<FindDelimiterFunc, Buffer>
+    tokenize(Buffer buffer, FindDelimiterFunc find_delimiter_func)
+    {
+        return {std::move(buffer), std::move(find_delimiter_func)};
+    }
 }
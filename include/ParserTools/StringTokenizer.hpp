@@ -6,7 +6,12 @@
 // License text is included with the source distribution.
 //****************************************************************************
 #pragma once
+#include <algorithm>
 #include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <span>
 #include <string_view>
 #include <vector>
 
@@ -164,24 +169,134 @@ namespace ParserTools
         return {str, std::move(find_delimiter_func)};
     }
 
-    template <typename FindDelimiterFunc>
-    std::vector<std::string_view>
-    split(std::string_view str, FindDelimiterFunc find_delimiter_func, size_t maxSplits = SIZE_MAX)
+    namespace Details
     {
-        if (maxSplits == 0)
-          return {str};
-
-        std::vector<std::string_view> result;
-        auto tokenizer = tokenize(str, std::move(find_delimiter_func));
-        for (auto item : tokenizer)
+        /**
+         * @brief Calls @a add_part with each part of @a str, and returns
+         *  true if the last part is the remainder after @a max_splits
+         *  splits.
+         */
+        template <typename FindDelimiterFunc, typename AddPartFunc>
+        constexpr bool split(std::string_view str,
+                             FindDelimiterFunc find_delimiter_func,
+                             size_t max_splits,
+                             AddPartFunc add_part)
         {
-            result.push_back(item.string());
-            if (--maxSplits == 0 || (item.remainder().empty() && !item.token().empty()))
+            if (max_splits == 0)
             {
-              result.push_back(item.remainder());
-              break;
+                add_part(str);
+                return true;
             }
+
+            for (auto item : tokenize(str, std::move(find_delimiter_func)))
+            {
+                add_part(item.string());
+                // Without a delimiter this is the last part.
+                if (item.token().empty())
+                    break;
+                if (--max_splits == 0 || item.remainder().empty())
+                {
+                    add_part(item.remainder());
+                    return max_splits == 0;
+                }
+            }
+            return false;
         }
+    }
+
+    template <typename FindDelimiterFunc>
+    std::vector<std::string_view>
+    split(std::string_view str, FindDelimiterFunc find_delimiter_func, size_t maxSplits = SIZE_MAX)
+    {
+        std::vector<std::string_view> result;
+        Details::split(str, std::move(find_delimiter_func), maxSplits,
+                       [&](std::string_view part) {result.push_back(part);});
         return result;
     }
+
+    /**
+     * @brief Returns the number of parts split() returns for the same
+     *  arguments.
+     */
+    template <typename FindDelimiterFunc>
+    constexpr size_t
+    count_split_parts(std::string_view str, FindDelimiterFunc find_delimiter_func,
+                      size_t maxSplits = SIZE_MAX)
+    {
+        size_t count = 0;
+        Details::split(str, std::move(find_delimiter_func), maxSplits,
+                       [&](std::string_view) {++count;});
+        return count;
+    }
+
+    /**
+     * @brief Writes the parts split() returns to @a out and returns
+     *  the iterator past the last part.
+     */
+    template <typename FindDelimiterFunc,
+              std::output_iterator<std::string_view> OutputIt>
+    constexpr OutputIt
+    split(std::string_view str, FindDelimiterFunc find_delimiter_func,
+          OutputIt out, size_t maxSplits = SIZE_MAX)
+    {
+        Details::split(str, std::move(find_delimiter_func), maxSplits,
+                       [&](std::string_view part) {*out++ = part;});
+        return out;
+    }
+
+    /**
+     * @brief Replaces the contents of @a result with the parts split()
+     *  returns, reusing its memory, and returns the number of parts.
+     */
+    template <typename FindDelimiterFunc, typename Allocator>
+    size_t split(std::string_view str, FindDelimiterFunc find_delimiter_func,
+                 std::vector<std::string_view, Allocator>& result,
+                 size_t maxSplits = SIZE_MAX)
+    {
+        result.clear();
+        Details::split(str, std::move(find_delimiter_func), maxSplits,
+                       [&](std::string_view part) {result.push_back(part);});
+        return result.size();
+    }
+
+    struct SplitResult
+    {
+        /**
+         * @brief The number of parts written.
+         */
+        size_t size = 0;
+        /**
+         * @brief True if there were more parts than there was room for.
+         */
+        bool overflow = false;
+    };
+
+    /**
+     * @brief Writes the parts split() returns to @a result.
+     *
+     * If there are more parts than there is room for in @a result, the
+     * last element is the unsplit remainder of @a str (as if
+     * maxSplits was result.size() - 1), and the overflow flag is set.
+     * Use count_split_parts() to get the required size in advance.
+     */
+    template <typename FindDelimiterFunc>
+    constexpr SplitResult
+    split(std::string_view str, FindDelimiterFunc find_delimiter_func,
+          std::span<std::string_view> result, size_t maxSplits = SIZE_MAX)
+    {
+        if (result.empty())
+            return {0, true};
+
+        auto max_splits = std::min(maxSplits, result.size() - 1);
+        size_t size = 0;
+        auto limited = Details::split(str, find_delimiter_func, max_splits,
+                                      [&](std::string_view part) {result[size++] = part;});
+        if (!limited || max_splits == maxSplits)
+            return {size, false};
+
+        // The last part contains more parts if it contains a delimiter.
+        auto remainder = result[size - 1];
+        auto delimiter = find_delimiter_func(remainder);
+        return {size, delimiter.first != remainder.size()};
+    }
 }
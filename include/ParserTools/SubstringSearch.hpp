@@ -0,0 +1,65 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+/**
+ * @file
+ * @brief Defines the SubstringSearcher class.
+ */
+
+namespace ParserTools
+{
+    /**
+     * @brief Searches strings for a fixed substring in linear time.
+     *
+     * All tables are computed by the constructor. Needles up to
+     * SHORT_NEEDLE_SIZE bytes are found with a vectorized filter on their
+     * first and last bytes, longer needles with the Two-Way algorithm
+     * combined with a Horspool shift on the last byte. The filter falls back
+     * to Two-Way if the input produces too many false candidates, so the
+     * worst-case time is linear for all needles.
+     *
+     * The searcher does not copy the needle, it must outlive the searcher.
+     */
+    class SubstringSearcher
+    {
+    public:
+        static constexpr size_t SHORT_NEEDLE_SIZE = 32;
+
+        SubstringSearcher() = default;
+
+        explicit SubstringSearcher(std::string_view needle);
+
+        /**
+         * @brief Returns the position of the first occurrence of the needle
+         *  in @a str, or str.size() if there is none.
+         *
+         * An empty needle is found at position 0.
+         */
+        [[nodiscard]] size_t find(std::string_view str) const;
+
+        [[nodiscard]] std::string_view needle() const
+        {
+            return needle_;
+        }
+    private:
+        [[nodiscard]] size_t find_two_way(std::string_view str) const;
+
+        [[nodiscard]] size_t find_two_way_periodic(std::string_view str) const;
+
+        std::string_view needle_;
+        size_t suffix_ = 0;
+        size_t period_ = 0;
+        bool is_periodic_ = false;
+        std::array<uint8_t, 256> shifts_ = {};
+    };
+}
@@ -0,0 +1,65 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+/**
+ * @file
+ * @brief Defines the ThreadPool class.
+ */
+
+namespace ParserTools
+{
+    namespace Details
+    {
+        struct ThreadPoolContext;
+    }
+
+    /**
+     * @brief A fixed set of worker threads that run indexed tasks.
+     */
+    class ThreadPool
+    {
+    public:
+        /**
+         * @brief Starts @a thread_count - 1 worker threads, the thread
+         *  calling run() is the last one.
+         *
+         * If @a thread_count is 0, the number of hardware threads is used.
+         */
+        explicit ThreadPool(size_t thread_count = 0);
+
+        ThreadPool(const ThreadPool&) = delete;
+
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        ~ThreadPool();
+
+        /**
+         * @brief Returns the number of threads that run tasks, including
+         *  the one calling run().
+         */
+        [[nodiscard]]
+        size_t thread_count() const;
+
+        /**
+         * @brief Calls @a task(i) for every i in [0, @a task_count) and
+         *  returns when all calls have returned.
+         *
+         * The calls are made concurrently and in no particular order.
+         * If any of them throws, the remaining tasks are skipped and the
+         * first exception is rethrown. run() must not be called by two
+         * threads at the same time, or from inside a task.
+         */
+        void run(size_t task_count, const std::function<void(size_t)>& task);
+    private:
+        std::unique_ptr<Details::ThreadPoolContext> context_;
+    };
+}
@@ -0,0 +1,190 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "ParserTools/AhoCorasick.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace ParserTools
+{
+    namespace
+    {
+        constexpr uint32_t NO_STATE = UINT32_MAX;
+    }
+
+    AhoCorasickAutomaton::AhoCorasickAutomaton()
+        : transitions_(1, 0),
+          states_(1)
+    {}
+
+    AhoCorasickAutomaton::AhoCorasickAutomaton(
+            const std::vector<std::string_view>& patterns)
+    {
+        build(patterns);
+    }
+
+    PatternMatch AhoCorasickAutomaton::find(std::string_view str) const
+    {
+        PatternMatch best = {str.size(), str.size(), NO_PATTERN};
+        uint32_t state = 0;
+        for (size_t i = 0; i < str.size(); ++i)
+        {
+            if (state == 0)
+            {
+                i += find_byte_in(str.substr(i), first_bytes_);
+                if (i == str.size())
+                    break;
+            }
+
+            auto next = next_state(state, str[i]);
+            state = next & ~MATCH_FLAG;
+            if (next & MATCH_FLAG)
+            {
+                const auto& info = states_[state];
+                auto start = i + 1 - info.match_length;
+                // A later match with the same start is longer.
+                if (best.pattern == NO_PATTERN || start <= best.start)
+                    best = {start, i + 1, info.match_pattern};
+            }
+
+            // Matches that end after this point start after best.start.
+            if (best.pattern != NO_PATTERN && i + 1 >= best.start + max_length_)
+                break;
+        }
+        return best;
+    }
+
+    size_t AhoCorasickAutomaton::index_of(std::string_view str) const
+    {
+        uint32_t state = 0;
+        for (auto c : str)
+            state = next_state(state, c) & ~MATCH_FLAG;
+        const auto& info = states_[state];
+        if (info.depth != str.size() || info.own_pattern == uint32_t(NO_PATTERN))
+            return NO_PATTERN;
+        return info.own_pattern;
+    }
+
+    size_t AhoCorasickAutomaton::pattern_count() const
+    {
+        return patterns_.size();
+    }
+
+    std::string_view AhoCorasickAutomaton::pattern(size_t index) const
+    {
+        return patterns_[index];
+    }
+
+    size_t AhoCorasickAutomaton::max_pattern_length() const
+    {
+        return max_length_;
+    }
+
+    size_t AhoCorasickAutomaton::state_count() const
+    {
+        return states_.size();
+    }
+
+    void AhoCorasickAutomaton::build(const std::vector<std::string_view>& patterns)
+    {
+        patterns_.assign(patterns.begin(), patterns.end());
+
+        // Give each byte that occurs in the patterns its own column,
+        // all other bytes share column 0.
+        std::string first_bytes;
+        for (auto pattern : patterns_)
+        {
+            if (pattern.empty())
+                continue;
+            first_bytes.push_back(pattern[0]);
+            max_length_ = std::max(max_length_, pattern.size());
+            for (auto c : pattern)
+            {
+                auto& cls = classes_[uint8_t(c)];
+                if (cls == 0)
+                    cls = uint16_t(class_count_++);
+            }
+        }
+        first_bytes_ = ByteSet(first_bytes);
+
+        // Build the trie.
+        transitions_.assign(class_count_, NO_STATE);
+        states_.assign(1, StateInfo());
+        for (size_t i = 0; i < patterns_.size(); ++i)
+        {
+            uint32_t state = 0;
+            for (auto c : patterns_[i])
+            {
+                auto& next = transitions_[state * class_count_ + classes_[uint8_t(c)]];
+                if (next == NO_STATE)
+                {
+                    if (states_.size() >= MATCH_FLAG)
+                        throw std::length_error("Too many Aho-Corasick states.");
+                    next = uint32_t(states_.size());
+                    states_.push_back({states_[state].depth + 1});
+                    transitions_.resize(transitions_.size() + class_count_, NO_STATE);
+                }
+                // transitions_ may have been reallocated.
+                state = transitions_[state * class_count_ + classes_[uint8_t(c)]];
+            }
+            if (!patterns_[i].empty() && states_[state].own_pattern == uint32_t(NO_PATTERN))
+                states_[state].own_pattern = uint32_t(i);
+        }
+
+        // Add the failure transitions in breadth-first order, making
+        // the automaton deterministic.
+        std::vector<uint32_t> failures(states_.size(), 0);
+        std::vector<uint32_t> queue;
+        queue.reserve(states_.size());
+        for (size_t c = 0; c < class_count_; ++c)
+        {
+            auto& next = transitions_[c];
+            if (next == NO_STATE)
+                next = 0;
+            else
+                queue.push_back(next);
+        }
+
+        for (size_t i = 0; i < queue.size(); ++i)
+        {
+            auto state = queue[i];
+            auto& info = states_[state];
+            auto& failure_info = states_[failures[state]];
+            if (info.own_pattern != uint32_t(NO_PATTERN))
+            {
+                info.match_length = info.depth;
+                info.match_pattern = info.own_pattern;
+            }
+            else
+            {
+                info.match_length = failure_info.match_length;
+                info.match_pattern = failure_info.match_pattern;
+            }
+
+            auto row = transitions_.data() + state * class_count_;
+            auto failure_row = transitions_.data() + failures[state] * class_count_;
+            for (size_t c = 0; c < class_count_; ++c)
+            {
+                if (row[c] == NO_STATE)
+                {
+                    row[c] = failure_row[c];
+                }
+                else
+                {
+                    failures[row[c]] = failure_row[c] & ~MATCH_FLAG;
+                    queue.push_back(row[c]);
+                }
+            }
+        }
+
+        for (auto& next : transitions_)
+        {
+            if (states_[next & ~MATCH_FLAG].match_length != 0)
+                next |= MATCH_FLAG;
+        }
+    }
+}
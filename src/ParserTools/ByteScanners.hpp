@@ -0,0 +1,167 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include "ParserTools/SimdLevel.hpp"
+#include "SimdUtilities.hpp"
+
+/**
+ * @file
+ * @brief Generic loops that search for the first byte accepted by a matcher.
+ *
+ * A matcher is a class with a function
+ * `size_t scalar(const char*, size_t) const` and the nested classes
+ * Sse2, Avx2 and Avx512. The nested classes are constructed from the
+ * matcher inside the vectorized loop (so their constants end up in
+ * registers) and turn a vector of bytes into either a vector where the
+ * matching bytes are 0xFF and the others are 0 (SSE2, AVX2), or a bit
+ * mask (AVX-512). Matchers that
+ * need instructions that are not part of SSE2 can leave out Sse2, the
+ * scalar function is then used instead.
+ */
+
+namespace ParserTools::Details
+{
+#if PARSERTOOLS_X86
+    PARSERTOOLS_TARGET_SSE2
+    inline __m128i load_sse2(const char* p)
+    {
+        return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    }
+
+    PARSERTOOLS_TARGET_AVX2
+    inline __m256i load_avx2(const char* p)
+    {
+        return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    }
+
+    template <typename Matcher>
+    constexpr bool HAS_SSE2_MATCHER = requires { typename Matcher::Sse2; };
+
+    template <typename Matcher>
+    PARSERTOOLS_TARGET_SSE2
+    size_t scan_sse2_impl(const char* data, size_t size, const Matcher& matcher)
+    {
+        if (size < 16)
+            return matcher.scalar(data, size);
+
+        const typename Matcher::Sse2 match(matcher);
+        size_t i = 0;
+        for (; i + 16 <= size; i += 16)
+        {
+            auto mask = uint32_t(_mm_movemask_epi8(match(load_sse2(data + i))));
+            if (mask)
+                return i + std::countr_zero(mask);
+        }
+
+        if (i == size)
+            return size;
+
+        // Re-read the last 16 bytes and ignore the ones that have
+        // already been checked.
+        auto mask = uint32_t(_mm_movemask_epi8(match(load_sse2(data + size - 16))));
+        mask >>= 16 - (size - i);
+        return mask ? i + std::countr_zero(mask) : size;
+    }
+
+    template <typename Matcher>
+    PARSERTOOLS_TARGET_SSE2
+    size_t scan_sse2(const char* data, size_t size, const Matcher& matcher)
+    {
+        if constexpr (!HAS_SSE2_MATCHER<Matcher>)
+            return matcher.scalar(data, size);
+        else
+            return scan_sse2_impl(data, size, matcher);
+    }
+
+    template <typename Matcher>
+    PARSERTOOLS_TARGET_AVX2
+    size_t scan_avx2(const char* data, size_t size, const Matcher& matcher)
+    {
+        if (size < 32)
+            return scan_sse2(data, size, matcher);
+
+        const typename Matcher::Avx2 match(matcher);
+        size_t i = 0;
+        for (; i + 64 <= size; i += 64)
+        {
+            auto a = match(load_avx2(data + i));
+            auto b = match(load_avx2(data + i + 32));
+            if (!_mm256_testz_si256(_mm256_or_si256(a, b), _mm256_or_si256(a, b)))
+            {
+                auto lo = uint64_t(uint32_t(_mm256_movemask_epi8(a)));
+                auto hi = uint64_t(uint32_t(_mm256_movemask_epi8(b)));
+                return i + std::countr_zero(lo | (hi << 32));
+            }
+        }
+
+        if (i + 32 <= size)
+        {
+            auto mask = uint32_t(_mm256_movemask_epi8(match(load_avx2(data + i))));
+            if (mask)
+                return i + std::countr_zero(mask);
+            i += 32;
+        }
+
+        if (i == size)
+            return size;
+
+        auto mask = uint32_t(_mm256_movemask_epi8(match(load_avx2(data + size - 32))));
+        mask >>= 32 - (size - i);
+        return mask ? i + std::countr_zero(mask) : size;
+    }
+
+    template <typename Matcher>
+    PARSERTOOLS_TARGET_AVX512
+    size_t scan_avx512(const char* data, size_t size, const Matcher& matcher)
+    {
+        if (size < 32)
+            return scan_sse2(data, size, matcher);
+
+        const typename Matcher::Avx512 match(matcher);
+        size_t i = 0;
+        for (; i + 64 <= size; i += 64)
+        {
+            auto mask = uint64_t(match(_mm512_loadu_si512(data + i)));
+            if (mask)
+                return i + std::countr_zero(mask);
+        }
+
+        if (i == size)
+            return size;
+
+        // Masked loads do not fault on the bytes that are left out,
+        // but the zeroed bytes may match and must be masked away.
+        auto load_mask = __mmask64((uint64_t(1) << (size - i)) - 1);
+        auto mask = uint64_t(match(_mm512_maskz_loadu_epi8(load_mask, data + i)))
+                    & load_mask;
+        return mask ? i + std::countr_zero(mask) : size;
+    }
+#endif
+
+    template <typename Matcher>
+    size_t scan(const char* data, size_t size, const Matcher& matcher,
+                SimdLevel level)
+    {
+        switch (level)
+        {
+    #if PARSERTOOLS_X86
+        case SimdLevel::AVX512:
+            return scan_avx512(data, size, matcher);
+        case SimdLevel::AVX2:
+            return scan_avx2(data, size, matcher);
+        case SimdLevel::SSE2:
+            return scan_sse2(data, size, matcher);
+    #endif
+        default:
+            return matcher.scalar(data, size);
+        }
+    }
+}
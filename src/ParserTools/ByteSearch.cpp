@@ -0,0 +1,429 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "ParserTools/ByteSearch.hpp"
+#include <algorithm>
+#include <bit>
+#include "ByteScanners.hpp"
+
+namespace ParserTools
+{
+    namespace
+    {
+        struct ByteMatcher
+        {
+            char ch;
+
+            size_t scalar(const char* data, size_t size) const
+            {
+                return size_t(std::find(data, data + size, ch) - data);
+            }
+
+        #if PARSERTOOLS_X86
+            struct Sse2
+            {
+                PARSERTOOLS_TARGET_SSE2
+                explicit Sse2(const ByteMatcher& m)
+                    : needle(_mm_set1_epi8(m.ch))
+                {}
+
+                PARSERTOOLS_TARGET_SSE2
+                __m128i operator()(__m128i v) const
+                {
+                    return _mm_cmpeq_epi8(v, needle);
+                }
+
+                __m128i needle;
+            };
+
+            struct Avx2
+            {
+                PARSERTOOLS_TARGET_AVX2
+                explicit Avx2(const ByteMatcher& m)
+                    : needle(_mm256_set1_epi8(m.ch))
+                {}
+
+                PARSERTOOLS_TARGET_AVX2
+                __m256i operator()(__m256i v) const
+                {
+                    return _mm256_cmpeq_epi8(v, needle);
+                }
+
+                __m256i needle;
+            };
+
+            struct Avx512
+            {
+                PARSERTOOLS_TARGET_AVX512
+                explicit Avx512(const ByteMatcher& m)
+                    : needle(_mm512_set1_epi8(m.ch))
+                {}
+
+                PARSERTOOLS_TARGET_AVX512
+                __mmask64 operator()(__m512i v) const
+                {
+                    return _mm512_cmpeq_epi8_mask(v, needle);
+                }
+
+                __m512i needle;
+            };
+        #endif
+        };
+
+        struct NewlineMatcher
+        {
+            size_t scalar(const char* data, size_t size) const
+            {
+                return size_t(std::find_if(data, data + size, [](char c)
+                {
+                    return c == '\n' || c == '\r';
+                }) - data);
+            }
+
+        #if PARSERTOOLS_X86
+            struct Sse2
+            {
+                PARSERTOOLS_TARGET_SSE2
+                explicit Sse2(const NewlineMatcher&)
+                    : lf(_mm_set1_epi8('\n')),
+                      cr(_mm_set1_epi8('\r'))
+                {}
+
+                PARSERTOOLS_TARGET_SSE2
+                __m128i operator()(__m128i v) const
+                {
+                    return _mm_or_si128(_mm_cmpeq_epi8(v, lf),
+                                        _mm_cmpeq_epi8(v, cr));
+                }
+
+                __m128i lf;
+                __m128i cr;
+            };
+
+            struct Avx2
+            {
+                PARSERTOOLS_TARGET_AVX2
+                explicit Avx2(const NewlineMatcher&)
+                    : lf(_mm256_set1_epi8('\n')),
+                      cr(_mm256_set1_epi8('\r'))
+                {}
+
+                PARSERTOOLS_TARGET_AVX2
+                __m256i operator()(__m256i v) const
+                {
+                    return _mm256_or_si256(_mm256_cmpeq_epi8(v, lf),
+                                           _mm256_cmpeq_epi8(v, cr));
+                }
+
+                __m256i lf;
+                __m256i cr;
+            };
+
+            struct Avx512
+            {
+                PARSERTOOLS_TARGET_AVX512
+                explicit Avx512(const NewlineMatcher&)
+                    : lf(_mm512_set1_epi8('\n')),
+                      cr(_mm512_set1_epi8('\r'))
+                {}
+
+                PARSERTOOLS_TARGET_AVX512
+                __mmask64 operator()(__m512i v) const
+                {
+                    return _mm512_cmpeq_epi8_mask(v, lf)
+                           | _mm512_cmpeq_epi8_mask(v, cr);
+                }
+
+                __m512i lf;
+                __m512i cr;
+            };
+        #endif
+        };
+
+        template <bool Negate, bool TwoTables>
+        struct ByteSetMatcher
+        {
+            const ByteSet& set;
+
+            size_t scalar(const char* data, size_t size) const
+            {
+                for (size_t i = 0; i < size; ++i)
+                {
+                    if (set.contains(data[i]) != Negate)
+                        return i;
+                }
+                return size;
+            }
+
+        #if PARSERTOOLS_X86
+            struct Avx2
+            {
+                PARSERTOOLS_TARGET_AVX2
+                explicit Avx2(const ByteSetMatcher& m)
+                    : low_nibble_mask(_mm256_set1_epi8(0x0F))
+                {
+                    for (size_t i = 0; i < (TwoTables ? 2 : 1); ++i)
+                    {
+                        low_tables[i] = _mm256_broadcastsi128_si256(
+                            _mm_loadu_si128(reinterpret_cast<const __m128i*>(
+                                m.set.low_nibbles(i).data())));
+                        high_tables[i] = _mm256_broadcastsi128_si256(
+                            _mm_loadu_si128(reinterpret_cast<const __m128i*>(
+                                m.set.high_nibbles(i).data())));
+                    }
+                }
+
+                PARSERTOOLS_TARGET_AVX2
+                __m256i operator()(__m256i v) const
+                {
+                    auto lo = _mm256_and_si256(v, low_nibble_mask);
+                    auto hi = _mm256_and_si256(_mm256_srli_epi16(v, 4),
+                                               low_nibble_mask);
+                    auto bits = _mm256_and_si256(
+                        _mm256_shuffle_epi8(low_tables[0], lo),
+                        _mm256_shuffle_epi8(high_tables[0], hi));
+                    if constexpr (TwoTables)
+                    {
+                        bits = _mm256_or_si256(bits, _mm256_and_si256(
+                            _mm256_shuffle_epi8(low_tables[1], lo),
+                            _mm256_shuffle_epi8(high_tables[1], hi)));
+                    }
+                    auto not_members = _mm256_cmpeq_epi8(bits, _mm256_setzero_si256());
+                    if constexpr (Negate)
+                        return not_members;
+                    else
+                        return _mm256_xor_si256(not_members, _mm256_set1_epi8(-1));
+                }
+
+                __m256i low_nibble_mask;
+                __m256i low_tables[2];
+                __m256i high_tables[2];
+            };
+
+            struct Avx512
+            {
+                PARSERTOOLS_TARGET_AVX512
+                explicit Avx512(const ByteSetMatcher& m)
+                    : low_nibble_mask(_mm512_set1_epi8(0x0F))
+                {
+                    for (size_t i = 0; i < (TwoTables ? 2 : 1); ++i)
+                    {
+                        low_tables[i] = _mm512_broadcast_i32x4(
+                            _mm_loadu_si128(reinterpret_cast<const __m128i*>(
+                                m.set.low_nibbles(i).data())));
+                        high_tables[i] = _mm512_broadcast_i32x4(
+                            _mm_loadu_si128(reinterpret_cast<const __m128i*>(
+                                m.set.high_nibbles(i).data())));
+                    }
+                }
+
+                PARSERTOOLS_TARGET_AVX512
+                __mmask64 operator()(__m512i v) const
+                {
+                    auto lo = _mm512_and_si512(v, low_nibble_mask);
+                    auto hi = _mm512_and_si512(_mm512_srli_epi16(v, 4),
+                                               low_nibble_mask);
+                    auto members = _mm512_test_epi8_mask(
+                        _mm512_shuffle_epi8(low_tables[0], lo),
+                        _mm512_shuffle_epi8(high_tables[0], hi));
+                    if constexpr (TwoTables)
+                    {
+                        members |= _mm512_test_epi8_mask(
+                            _mm512_shuffle_epi8(low_tables[1], lo),
+                            _mm512_shuffle_epi8(high_tables[1], hi));
+                    }
+                    if constexpr (Negate)
+                        return __mmask64(~uint64_t(members));
+                    else
+                        return members;
+                }
+
+                __m512i low_nibble_mask;
+                __m512i low_tables[2];
+                __m512i high_tables[2];
+            };
+        #endif
+        };
+
+        template <bool Negate>
+        size_t find_in_byte_set(std::string_view str, const ByteSet& set)
+        {
+            if (set.table_count() == 2)
+            {
+                return Details::scan(str.data(), str.size(),
+                                     ByteSetMatcher<Negate, true>{set},
+                                     simd_level());
+            }
+            return Details::scan(str.data(), str.size(),
+                                 ByteSetMatcher<Negate, false>{set},
+                                 simd_level());
+        }
+
+        /**
+         * @brief Returns the position of set bit number @a n in @a mask,
+         *  @a mask must have more than @a n bits set.
+         */
+        inline unsigned select_bit(uint64_t mask, size_t n)
+        {
+            for (; n != 0; --n)
+                mask &= mask - 1;
+            return unsigned(std::countr_zero(mask));
+        }
+
+        size_t find_nth_byte_scalar(std::string_view str, char ch, size_t n)
+        {
+            for (size_t i = 0; i < str.size(); ++i)
+            {
+                if (str[i] == ch && n-- == 0)
+                    return i;
+            }
+            return str.size();
+        }
+
+        /**
+         * @brief Counts the matches in blocks of 64 bytes and only looks
+         *  for the position of the match in the block that has it.
+         *
+         * @a get_mask returns a bit mask of the matching bytes in the
+         * 64 bytes starting at its argument.
+         */
+        template <typename GetMaskFunc>
+        size_t find_nth_in_blocks(std::string_view str, size_t n,
+                                  const GetMaskFunc& get_mask)
+        {
+            size_t i = 0;
+            for (; i + 64 <= str.size(); i += 64)
+            {
+                auto mask = get_mask(str.data() + i);
+                auto count = size_t(std::popcount(mask));
+                if (n < count)
+                    return i + select_bit(mask, n);
+                n -= count;
+            }
+
+            if (i == str.size())
+                return str.size();
+
+            // The zero padding matches if ch is '\0', those bits are
+            // removed.
+            const auto count = str.size() - i;
+            alignas(64) char block[64] = {};
+            std::copy(str.data() + i, str.data() + str.size(), block);
+            auto mask = get_mask(block) & ((uint64_t(1) << count) - 1);
+            if (n < size_t(std::popcount(mask)))
+                return i + select_bit(mask, n);
+            return str.size();
+        }
+
+    #if PARSERTOOLS_X86
+        struct Sse2ByteMask
+        {
+            PARSERTOOLS_TARGET_SSE2
+            uint64_t operator()(const char* data) const
+            {
+                uint64_t mask = 0;
+                for (unsigned j = 0; j < 4; ++j)
+                {
+                    auto v = match(Details::load_sse2(data + 16 * j));
+                    mask |= uint64_t(uint32_t(_mm_movemask_epi8(v))) << (16 * j);
+                }
+                return mask;
+            }
+
+            ByteMatcher::Sse2 match;
+        };
+
+        struct Avx2ByteMask
+        {
+            PARSERTOOLS_TARGET_AVX2
+            uint64_t operator()(const char* data) const
+            {
+                auto lo = uint32_t(_mm256_movemask_epi8(match(Details::load_avx2(data))));
+                auto hi = uint32_t(_mm256_movemask_epi8(match(Details::load_avx2(data + 32))));
+                return lo | (uint64_t(hi) << 32);
+            }
+
+            ByteMatcher::Avx2 match;
+        };
+
+        struct Avx512ByteMask
+        {
+            PARSERTOOLS_TARGET_AVX512
+            uint64_t operator()(const char* data) const
+            {
+                return uint64_t(match(_mm512_loadu_si512(data)));
+            }
+
+            ByteMatcher::Avx512 match;
+        };
+
+        PARSERTOOLS_TARGET_SSE2
+        size_t find_nth_byte_sse2(std::string_view str, char ch, size_t n)
+        {
+            const Sse2ByteMask get_mask{ByteMatcher::Sse2(ByteMatcher{ch})};
+            return find_nth_in_blocks(str, n, get_mask);
+        }
+
+        PARSERTOOLS_TARGET_AVX2
+        size_t find_nth_byte_avx2(std::string_view str, char ch, size_t n)
+        {
+            const Avx2ByteMask get_mask{ByteMatcher::Avx2(ByteMatcher{ch})};
+            return find_nth_in_blocks(str, n, get_mask);
+        }
+
+        PARSERTOOLS_TARGET_AVX512
+        size_t find_nth_byte_avx512(std::string_view str, char ch, size_t n)
+        {
+            const Avx512ByteMask get_mask{ByteMatcher::Avx512(ByteMatcher{ch})};
+            return find_nth_in_blocks(str, n, get_mask);
+        }
+    #endif
+    }
+
+    size_t find_byte(std::string_view str, char ch)
+    {
+        return Details::scan(str.data(), str.size(), ByteMatcher{ch},
+                             simd_level());
+    }
+
+    size_t find_nth_byte(std::string_view str, char ch, size_t n)
+    {
+        // Short strings are searched without counting.
+        if (str.size() < 64)
+            return find_nth_byte_scalar(str, ch, n);
+
+        switch (simd_level())
+        {
+    #if PARSERTOOLS_X86
+        case SimdLevel::AVX512:
+            return find_nth_byte_avx512(str, ch, n);
+        case SimdLevel::AVX2:
+            return find_nth_byte_avx2(str, ch, n);
+        case SimdLevel::SSE2:
+            return find_nth_byte_sse2(str, ch, n);
+    #endif
+        default:
+            return find_nth_byte_scalar(str, ch, n);
+        }
+    }
+
+    size_t find_newline_byte(std::string_view str)
+    {
+        return Details::scan(str.data(), str.size(), NewlineMatcher{},
+                             simd_level());
+    }
+
+    size_t find_byte_in(std::string_view str, const ByteSet& set)
+    {
+        return find_in_byte_set<false>(str, set);
+    }
+
+    size_t find_byte_not_in(std::string_view str, const ByteSet& set)
+    {
+        return find_in_byte_set<true>(str, set);
+    }
+}
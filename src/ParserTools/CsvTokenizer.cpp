@@ -0,0 +1,256 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "ParserTools/CsvTokenizer.hpp"
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include "ParserTools/SimdLevel.hpp"
+#include "SimdUtilities.hpp"
+
+namespace ParserTools::Details
+{
+    namespace
+    {
+        /**
+         * @brief Bit masks for the special characters in a block of
+         *  64 bytes, bit i corresponds to byte i.
+         */
+        struct CsvBlockMasks
+        {
+            uint64_t quotes;
+            uint64_t delimiters;
+        };
+
+        /**
+         * @brief Returns a mask where bit i is the XOR of bits 0 to i
+         *  of @a x.
+         */
+        constexpr uint64_t prefix_xor(uint64_t x)
+        {
+            x ^= x << 1;
+            x ^= x << 2;
+            x ^= x << 4;
+            x ^= x << 8;
+            x ^= x << 16;
+            x ^= x << 32;
+            return x;
+        }
+
+        /**
+         * @brief Returns the position of the first delimiter outside
+         *  quotes in a block, or 64.
+         *
+         * @a inside is all ones if the block starts inside quotes and
+         * zero otherwise, it is updated to the state after the block.
+         */
+        constexpr unsigned find_in_block(const CsvBlockMasks& masks,
+                                         uint64_t& inside)
+        {
+            // Opening quotes are inside, closing quotes outside, which
+            // is fine since neither is a delimiter.
+            const auto quoted = prefix_xor(masks.quotes) ^ inside;
+            inside = uint64_t(int64_t(quoted) >> 63);
+            return unsigned(std::countr_zero(masks.delimiters & ~quoted));
+        }
+
+        size_t find_csv_delimiter_scalar(std::string_view str, char separator,
+                                         char quote)
+        {
+            bool inside = false;
+            for (size_t i = 0; i < str.size(); ++i)
+            {
+                auto c = str[i];
+                if (c == quote)
+                    inside = !inside;
+                else if (!inside && (c == separator || c == '\n' || c == '\r'))
+                    return i;
+            }
+            return str.size();
+        }
+
+        /**
+         * @brief Searches the blocks of @a str with @a get_masks, and the
+         *  final partial block through a zero-padded copy.
+         */
+        template <typename GetMasksFunc>
+        size_t find_in_blocks(std::string_view str, const GetMasksFunc& get_masks)
+        {
+            uint64_t inside = 0;
+            size_t i = 0;
+            for (; i + 64 <= str.size(); i += 64)
+            {
+                auto pos = find_in_block(get_masks(str.data() + i), inside);
+                if (pos != 64)
+                    return i + pos;
+            }
+
+            if (i == str.size())
+                return str.size();
+
+            // The padding can match a separator or quote that is '\0',
+            // those bits are removed.
+            const auto count = str.size() - i;
+            alignas(64) char block[64] = {};
+            std::memcpy(block, str.data() + i, count);
+            auto masks = get_masks(block);
+            const auto valid = (uint64_t(1) << count) - 1;
+            masks.quotes &= valid;
+            masks.delimiters &= valid;
+            auto pos = find_in_block(masks, inside);
+            return pos < count ? i + pos : str.size();
+        }
+
+    #if PARSERTOOLS_X86
+        struct Sse2Masks
+        {
+            PARSERTOOLS_TARGET_SSE2
+            Sse2Masks(char separator, char quote)
+                : separator(_mm_set1_epi8(separator)),
+                  quote(_mm_set1_epi8(quote)),
+                  newline(_mm_set1_epi8('\n')),
+                  carriage_return(_mm_set1_epi8('\r'))
+            {}
+
+            PARSERTOOLS_TARGET_SSE2
+            CsvBlockMasks operator()(const char* data) const
+            {
+                CsvBlockMasks masks = {0, 0};
+                for (unsigned j = 0; j < 4; ++j)
+                {
+                    auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16 * j));
+                    auto q = uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(v, quote)));
+                    auto d = uint32_t(_mm_movemask_epi8(
+                        _mm_or_si128(_mm_cmpeq_epi8(v, separator),
+                                     _mm_or_si128(_mm_cmpeq_epi8(v, newline),
+                                                  _mm_cmpeq_epi8(v, carriage_return)))));
+                    masks.quotes |= uint64_t(q) << (16 * j);
+                    masks.delimiters |= uint64_t(d) << (16 * j);
+                }
+                return masks;
+            }
+
+            __m128i separator;
+            __m128i quote;
+            __m128i newline;
+            __m128i carriage_return;
+        };
+
+        struct Avx2Masks
+        {
+            PARSERTOOLS_TARGET_AVX2
+            Avx2Masks(char separator, char quote)
+                : separator(_mm256_set1_epi8(separator)),
+                  quote(_mm256_set1_epi8(quote)),
+                  newline(_mm256_set1_epi8('\n')),
+                  carriage_return(_mm256_set1_epi8('\r'))
+            {}
+
+            PARSERTOOLS_TARGET_AVX2
+            uint32_t get_quotes(__m256i v) const
+            {
+                return uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, quote)));
+            }
+
+            PARSERTOOLS_TARGET_AVX2
+            uint32_t get_delimiters(__m256i v) const
+            {
+                return uint32_t(_mm256_movemask_epi8(
+                    _mm256_or_si256(_mm256_cmpeq_epi8(v, separator),
+                                    _mm256_or_si256(_mm256_cmpeq_epi8(v, newline),
+                                                    _mm256_cmpeq_epi8(v, carriage_return)))));
+            }
+
+            PARSERTOOLS_TARGET_AVX2
+            CsvBlockMasks operator()(const char* data) const
+            {
+                auto lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+                auto hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + 32));
+                return {get_quotes(lo) | (uint64_t(get_quotes(hi)) << 32),
+                        get_delimiters(lo) | (uint64_t(get_delimiters(hi)) << 32)};
+            }
+
+            __m256i separator;
+            __m256i quote;
+            __m256i newline;
+            __m256i carriage_return;
+        };
+
+        struct Avx512Masks
+        {
+            PARSERTOOLS_TARGET_AVX512
+            Avx512Masks(char separator, char quote)
+                : separator(_mm512_set1_epi8(separator)),
+                  quote(_mm512_set1_epi8(quote)),
+                  newline(_mm512_set1_epi8('\n')),
+                  carriage_return(_mm512_set1_epi8('\r'))
+            {}
+
+            PARSERTOOLS_TARGET_AVX512
+            CsvBlockMasks operator()(const char* data) const
+            {
+                auto v = _mm512_loadu_si512(data);
+                return {uint64_t(_mm512_cmpeq_epi8_mask(v, quote)),
+                        uint64_t(_mm512_cmpeq_epi8_mask(v, separator)
+                                 | _mm512_cmpeq_epi8_mask(v, newline)
+                                 | _mm512_cmpeq_epi8_mask(v, carriage_return))};
+            }
+
+            __m512i separator;
+            __m512i quote;
+            __m512i newline;
+            __m512i carriage_return;
+        };
+
+        PARSERTOOLS_TARGET_SSE2
+        size_t find_csv_delimiter_sse2(std::string_view str, char separator,
+                                       char quote)
+        {
+            const Sse2Masks masks(separator, quote);
+            return find_in_blocks(str, masks);
+        }
+
+        PARSERTOOLS_TARGET_AVX2
+        size_t find_csv_delimiter_avx2(std::string_view str, char separator,
+                                       char quote)
+        {
+            const Avx2Masks masks(separator, quote);
+            return find_in_blocks(str, masks);
+        }
+
+        PARSERTOOLS_TARGET_AVX512
+        size_t find_csv_delimiter_avx512(std::string_view str, char separator,
+                                         char quote)
+        {
+            const Avx512Masks masks(separator, quote);
+            return find_in_blocks(str, masks);
+        }
+    #endif
+    }
+
+    size_t find_csv_delimiter(std::string_view str, char separator, char quote)
+    {
+        // Short fields are more common than long ones, the vectorized
+        // functions are only worth it when there is a full block.
+        if (str.size() < 64)
+            return find_csv_delimiter_scalar(str, separator, quote);
+
+        switch (simd_level())
+        {
+    #if PARSERTOOLS_X86
+        case SimdLevel::AVX512:
+            return find_csv_delimiter_avx512(str, separator, quote);
+        case SimdLevel::AVX2:
+            return find_csv_delimiter_avx2(str, separator, quote);
+        case SimdLevel::SSE2:
+            return find_csv_delimiter_sse2(str, separator, quote);
+    #endif
+        default:
+            return find_csv_delimiter_scalar(str, separator, quote);
+        }
+    }
+}
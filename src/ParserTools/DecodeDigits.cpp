@@ -0,0 +1,240 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "ParserTools/DecodeDigits.hpp"
+#include <bit>
+#include <cstring>
+#include "ParserTools/ParseInteger.hpp"
+#include "ParserTools/SimdLevel.hpp"
+#include "SimdUtilities.hpp"
+
+namespace ParserTools
+{
+    namespace
+    {
+        /**
+         * @brief The state of a decoding, @a pos and @a out are where
+         *  the next digit is read and the next byte is written.
+         */
+        struct Decoding
+        {
+            std::string_view str;
+            uint8_t* out;
+            size_t pos = 0;
+        };
+
+        /**
+         * @brief Decodes the remaining digits one at a time with
+         *  Details::from_digit, which makes it the reference for the
+         *  faster implementations.
+         */
+        template <unsigned Bits>
+        ParseResult<size_t> decode_scalar(Decoding& d, uint8_t* first)
+        {
+            constexpr unsigned BASE = 1u << Bits;
+            unsigned acc = 0;
+            unsigned acc_bits = 0;
+            for (; d.pos < d.str.size(); ++d.pos)
+            {
+                auto digit = Details::from_digit<unsigned>(d.str[d.pos]);
+                if (digit >= BASE)
+                    return {0, d.pos, std::errc::invalid_argument};
+                acc = (acc << Bits) | digit;
+                acc_bits += Bits;
+                if (acc_bits >= 8)
+                {
+                    acc_bits -= 8;
+                    *d.out++ = uint8_t(acc >> acc_bits);
+                }
+            }
+            if (acc_bits != 0)
+                return {0, d.str.size(), std::errc::invalid_argument};
+            return {size_t(d.out - first), d.pos, {}};
+        }
+
+        uint64_t read_chunk(const char* p)
+        {
+            uint64_t chunk;
+            std::memcpy(&chunk, p, sizeof(chunk));
+            return chunk;
+        }
+
+        /**
+         * @brief Decodes blocks of eight binary digits as 64-bit words.
+         */
+        void decode_binary_swar(Decoding& d)
+        {
+            for (; d.pos + 8 <= d.str.size(); d.pos += 8)
+            {
+                auto chunk = read_chunk(d.str.data() + d.pos);
+                if ((chunk & 0xFEFEFEFEFEFEFEFEu) != 0x3030303030303030u)
+                    return;
+                // Moves bit 0 of byte i to bit 63 - i.
+                *d.out++ = uint8_t(((chunk & 0x0101010101010101u)
+                                    * 0x8040201008040201u) >> 56);
+            }
+        }
+
+        /**
+         * @brief Decodes blocks of eight octal digits as 64-bit words.
+         */
+        void decode_octal_swar(Decoding& d)
+        {
+            for (; d.pos + 8 <= d.str.size(); d.pos += 8)
+            {
+                auto chunk = read_chunk(d.str.data() + d.pos);
+                if ((chunk & 0xF8F8F8F8F8F8F8F8u) != 0x3030303030303030u)
+                    return;
+                // Combine the 3-bit values pairwise into 6, 12 and
+                // finally 24 bits. The first digit is in the lowest byte.
+                chunk -= 0x3030303030303030u;
+                chunk = ((chunk & 0x00FF00FF00FF00FFu) << 3)
+                        | ((chunk >> 8) & 0x00FF00FF00FF00FFu);
+                chunk = ((chunk & 0x0000FFFF0000FFFFu) << 6)
+                        | ((chunk >> 16) & 0x0000FFFF0000FFFFu);
+                chunk = ((chunk & 0xFFFFFFFFu) << 12) | (chunk >> 32);
+                d.out[0] = uint8_t(chunk >> 16);
+                d.out[1] = uint8_t(chunk >> 8);
+                d.out[2] = uint8_t(chunk);
+                d.out += 3;
+            }
+        }
+
+    #if PARSERTOOLS_X86
+        /**
+         * @brief Decodes blocks of 16 hexadecimal digits.
+         *
+         * Stops at the first block with an invalid digit, the scalar
+         * function then finds its position.
+         */
+        PARSERTOOLS_TARGET_SSE2
+        void decode_hex_sse2(Decoding& d)
+        {
+            const auto zero = _mm_set1_epi8('0');
+            const auto nine = _mm_set1_epi8(9);
+            const auto five = _mm_set1_epi8(5);
+            const auto ten = _mm_set1_epi8(10);
+            const auto upper_case = _mm_set1_epi8(char(0xDF));
+            const auto a = _mm_set1_epi8('A');
+            const auto low_bytes = _mm_set1_epi16(0x00FF);
+            for (; d.pos + 16 <= d.str.size(); d.pos += 16)
+            {
+                auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(d.str.data() + d.pos));
+                auto digit = _mm_sub_epi8(v, zero);
+                auto is_digit = _mm_cmpeq_epi8(_mm_min_epu8(digit, nine), digit);
+                auto letter = _mm_sub_epi8(_mm_and_si128(v, upper_case), a);
+                auto is_letter = _mm_cmpeq_epi8(_mm_min_epu8(letter, five), letter);
+                if (_mm_movemask_epi8(_mm_or_si128(is_digit, is_letter)) != 0xFFFF)
+                    return;
+                auto value = _mm_or_si128(_mm_and_si128(is_digit, digit),
+                                          _mm_and_si128(is_letter, _mm_add_epi8(letter, ten)));
+                // The first digit of each pair is in the low byte.
+                value = _mm_or_si128(_mm_slli_epi16(_mm_and_si128(value, low_bytes), 4),
+                                     _mm_srli_epi16(value, 8));
+                _mm_storel_epi64(reinterpret_cast<__m128i*>(d.out),
+                                 _mm_packus_epi16(value, value));
+                d.out += 8;
+            }
+        }
+
+        /**
+         * @brief Decodes blocks of 32 hexadecimal digits.
+         */
+        PARSERTOOLS_TARGET_AVX2
+        void decode_hex_avx2(Decoding& d)
+        {
+            const auto zero = _mm256_set1_epi8('0');
+            const auto nine = _mm256_set1_epi8(9);
+            const auto five = _mm256_set1_epi8(5);
+            const auto ten = _mm256_set1_epi8(10);
+            const auto upper_case = _mm256_set1_epi8(char(0xDF));
+            const auto a = _mm256_set1_epi8('A');
+            const auto low_bytes = _mm256_set1_epi16(0x00FF);
+            for (; d.pos + 32 <= d.str.size(); d.pos += 32)
+            {
+                auto v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(d.str.data() + d.pos));
+                auto digit = _mm256_sub_epi8(v, zero);
+                auto is_digit = _mm256_cmpeq_epi8(_mm256_min_epu8(digit, nine), digit);
+                auto letter = _mm256_sub_epi8(_mm256_and_si256(v, upper_case), a);
+                auto is_letter = _mm256_cmpeq_epi8(_mm256_min_epu8(letter, five), letter);
+                if (uint32_t(_mm256_movemask_epi8(_mm256_or_si256(is_digit, is_letter))) != 0xFFFFFFFFu)
+                    return;
+                auto value = _mm256_or_si256(_mm256_and_si256(is_digit, digit),
+                                             _mm256_and_si256(is_letter, _mm256_add_epi8(letter, ten)));
+                value = _mm256_or_si256(_mm256_slli_epi16(_mm256_and_si256(value, low_bytes), 4),
+                                        _mm256_srli_epi16(value, 8));
+                // packus works within each 128-bit lane, move the two
+                // halves of the result next to each other.
+                auto packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(value, value), 0x08);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(d.out),
+                                 _mm256_castsi256_si128(packed));
+                d.out += 16;
+            }
+            decode_hex_sse2(d);
+        }
+    #endif
+
+        template <unsigned Bits>
+        ParseResult<size_t> decode(std::string_view str,
+                                   std::span<uint8_t> bytes,
+                                   void (*decode_fast)(Decoding&))
+        {
+            if (str.size() / 8 * Bits + str.size() % 8 * Bits / 8 > bytes.size())
+                return {0, 0, std::errc::result_out_of_range};
+            Decoding d{str, bytes.data()};
+            if (decode_fast)
+                decode_fast(d);
+            return decode_scalar<Bits>(d, bytes.data());
+        }
+    }
+
+    ParseResult<size_t> decode_hex(std::string_view str,
+                                   std::span<uint8_t> bytes)
+    {
+        void (*decode_fast)(Decoding&) = nullptr;
+        switch (simd_level())
+        {
+    #if PARSERTOOLS_X86
+        case SimdLevel::AVX512:
+        case SimdLevel::AVX2:
+            decode_fast = decode_hex_avx2;
+            break;
+        case SimdLevel::SSE2:
+            decode_fast = decode_hex_sse2;
+            break;
+    #endif
+        default:
+            break;
+        }
+        return decode<4>(str, bytes, decode_fast);
+    }
+
+    ParseResult<size_t> decode_octal(std::string_view str,
+                                     std::span<uint8_t> bytes)
+    {
+        void (*decode_fast)(Decoding&) = nullptr;
+        // The SWAR functions assume the first digit is in the lowest byte.
+        if constexpr (std::endian::native == std::endian::little)
+        {
+            if (simd_level() != SimdLevel::SCALAR)
+                decode_fast = decode_octal_swar;
+        }
+        return decode<3>(str, bytes, decode_fast);
+    }
+
+    ParseResult<size_t> decode_binary(std::string_view str,
+                                      std::span<uint8_t> bytes)
+    {
+        void (*decode_fast)(Decoding&) = nullptr;
+        if constexpr (std::endian::native == std::endian::little)
+        {
+            if (simd_level() != SimdLevel::SCALAR)
+                decode_fast = decode_binary_swar;
+        }
+        return decode<1>(str, bytes, decode_fast);
+    }
+}
@@ -0,0 +1,275 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "ParserTools/MappedFile.hpp"
+#include <algorithm>
+#include <string>
+#include <system_error>
+
+#ifdef _WIN32
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#else
+    #include <cerrno>
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace ParserTools
+{
+    namespace Details
+    {
+        struct MappedFileContext
+        {
+            ~MappedFileContext();
+
+        #ifdef _WIN32
+            HANDLE file = INVALID_HANDLE_VALUE;
+            HANDLE mapping = nullptr;
+        #else
+            int file = -1;
+        #endif
+            void* view = nullptr;
+            size_t view_size = 0;
+            uint64_t view_start = 0;
+            uint64_t file_size = 0;
+            size_t window_size = 0;
+            MappedFileOptions options;
+        };
+    }
+
+    namespace
+    {
+        [[noreturn]]
+        void throw_system_error(const std::string& message)
+        {
+        #ifdef _WIN32
+            throw std::system_error(int(GetLastError()), std::system_category(),
+                                    message);
+        #else
+            throw std::system_error(errno, std::generic_category(), message);
+        #endif
+        }
+
+        size_t get_mapping_granularity()
+        {
+        #ifdef _WIN32
+            SYSTEM_INFO info;
+            GetSystemInfo(&info);
+            return size_t(info.dwAllocationGranularity);
+        #else
+            return size_t(sysconf(_SC_PAGESIZE));
+        #endif
+        }
+
+        void unmap_view(Details::MappedFileContext& context)
+        {
+            if (!context.view)
+                return;
+        #ifdef _WIN32
+            UnmapViewOfFile(context.view);
+        #else
+            munmap(context.view, context.view_size);
+        #endif
+            context.view = nullptr;
+            context.view_size = 0;
+        }
+
+        void open_file(Details::MappedFileContext& context,
+                       const std::filesystem::path& path)
+        {
+        #ifdef _WIN32
+            DWORD flags = FILE_ATTRIBUTE_NORMAL;
+            if (context.options.sequential)
+                flags |= FILE_FLAG_SEQUENTIAL_SCAN;
+            context.file = CreateFileW(path.c_str(), GENERIC_READ,
+                                       FILE_SHARE_READ, nullptr,
+                                       OPEN_EXISTING, flags, nullptr);
+            if (context.file == INVALID_HANDLE_VALUE)
+                throw_system_error("Can't open " + path.string());
+
+            LARGE_INTEGER size;
+            if (!GetFileSizeEx(context.file, &size))
+                throw_system_error("Can't get the size of " + path.string());
+            context.file_size = uint64_t(size.QuadPart);
+
+            if (context.file_size != 0)
+            {
+                context.mapping = CreateFileMappingW(context.file, nullptr,
+                                                     PAGE_READONLY, 0, 0,
+                                                     nullptr);
+                if (!context.mapping)
+                    throw_system_error("Can't map " + path.string());
+            }
+        #else
+            context.file = ::open(path.c_str(), O_RDONLY);
+            if (context.file == -1)
+                throw_system_error("Can't open " + path.string());
+
+            struct stat info = {};
+            if (fstat(context.file, &info) != 0)
+                throw_system_error("Can't get the size of " + path.string());
+            context.file_size = uint64_t(info.st_size);
+        #endif
+        }
+
+        /**
+         * @brief Maps @a size bytes of the file from @a start and unmaps
+         *  the previous view.
+         *
+         * The previous view is only unmapped when the new one has been
+         * mapped, it remains valid if an exception is thrown.
+         */
+        const char* map_view(Details::MappedFileContext& context,
+                             uint64_t start, size_t size)
+        {
+            if (size == 0)
+            {
+                unmap_view(context);
+                return nullptr;
+            }
+
+        #ifdef _WIN32
+            auto view = MapViewOfFile(context.mapping, FILE_MAP_READ,
+                                      DWORD(start >> 32),
+                                      DWORD(start & 0xFFFFFFFFu), size);
+            if (!view)
+                throw_system_error("Can't map a view of the file");
+        #else
+            auto view = mmap(nullptr, size, PROT_READ, MAP_PRIVATE,
+                             context.file, off_t(start));
+            if (view == MAP_FAILED)
+                throw_system_error("Can't map a view of the file");
+            // The advice is a hint, errors are ignored.
+            if (context.options.sequential)
+                madvise(view, size, MADV_SEQUENTIAL);
+            #ifdef MADV_HUGEPAGE
+            if (context.options.huge_pages)
+                madvise(view, size, MADV_HUGEPAGE);
+            #endif
+        #endif
+
+            unmap_view(context);
+            context.view = view;
+            context.view_size = size;
+            context.view_start = start;
+            return static_cast<const char*>(view);
+        }
+    }
+
+    Details::MappedFileContext::~MappedFileContext()
+    {
+        unmap_view(*this);
+    #ifdef _WIN32
+        if (mapping)
+            CloseHandle(mapping);
+        if (file != INVALID_HANDLE_VALUE)
+            CloseHandle(file);
+    #else
+        if (file != -1)
+            ::close(file);
+    #endif
+    }
+
+    MappedFile::MappedFile() = default;
+
+    MappedFile::MappedFile(const std::filesystem::path& path,
+                           const MappedFileOptions& options)
+        : context_(std::make_unique<Details::MappedFileContext>())
+    {
+        context_->options = options;
+        open_file(*context_, path);
+
+        if (context_->file_size <= options.max_mapping_size)
+        {
+            context_->window_size = size_t(context_->file_size);
+        }
+        else
+        {
+            auto granularity = get_mapping_granularity();
+            context_->window_size = std::max(granularity,
+                options.max_mapping_size / granularity * granularity);
+        }
+
+        size_ = size_t(std::min<uint64_t>(context_->file_size,
+                                          context_->window_size));
+        data_ = map_view(*context_, 0, size_);
+    }
+
+    MappedFile::MappedFile(MappedFile&& other) noexcept
+        : context_(std::move(other.context_)),
+          data_(other.data_),
+          offset_(other.offset_),
+          size_(other.size_)
+    {
+        other.data_ = nullptr;
+        other.offset_ = other.size_ = 0;
+    }
+
+    MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+    {
+        context_ = std::move(other.context_);
+        data_ = other.data_;
+        offset_ = other.offset_;
+        size_ = other.size_;
+        other.data_ = nullptr;
+        other.offset_ = other.size_ = 0;
+        return *this;
+    }
+
+    MappedFile::~MappedFile() = default;
+
+    size_t MappedFile::file_size() const
+    {
+        return context_ ? size_t(context_->file_size) : 0;
+    }
+
+    bool MappedFile::is_windowed() const
+    {
+        return context_ && context_->window_size < context_->file_size;
+    }
+
+    bool MappedFile::fill()
+    {
+        if (!context_)
+            return false;
+
+        auto& context = *context_;
+        const auto window_end = context.view_start + size_;
+        if (window_end == context.file_size)
+            return false;
+
+        // Start the new window at the first unconsumed byte, rounded
+        // down to the mapping granularity. Grow the window if the
+        // unconsumed data fills all of it.
+        auto granularity = get_mapping_granularity();
+        auto position = context.view_start + offset_;
+        auto start = position / granularity * granularity;
+        auto window_size = context.window_size;
+        if (start == context.view_start)
+            window_size *= 2;
+
+        auto size = size_t(std::min<uint64_t>(window_size,
+                                               context.file_size - start));
+        data_ = map_view(context, start, size);
+        context.window_size = window_size;
+        offset_ = size_t(position - start);
+        size_ = size;
+        return true;
+    }
+
+    void MappedFile::close()
+    {
+        context_.reset();
+        data_ = nullptr;
+        offset_ = size_ = 0;
+    }
+}
@@ -0,0 +1,252 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "ParserTools/PrefetchingStreamBuffer.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <istream>
+#include <thread>
+#include <vector>
+
+namespace ParserTools
+{
+    namespace Details
+    {
+        constexpr size_t PREFETCH_BLOCK_COUNT = 2;
+
+        /**
+         * @brief A block of stream data with room in front of it for the
+         *  unconsumed end of the previous block.
+         */
+        struct PrefetchBlock
+        {
+            std::unique_ptr<char[]> buffer;
+            size_t size = 0;
+            bool is_last = false;
+        };
+
+        /**
+         * @brief The state shared by the helper thread and the buffer.
+         *
+         * The blocks form a single-producer/single-consumer ring: the
+         * helper thread fills block @a produced % N when
+         * produced - consumed < N, the buffer reads block
+         * @a consumed % N when consumed < produced and releases it by
+         * incrementing @a consumed.
+         */
+        struct PrefetchContext
+        {
+            PrefetchContext(std::istream* stream, size_t block_size);
+
+            ~PrefetchContext();
+
+            char* data(PrefetchBlock& block) const
+            {
+                return block.buffer.get() + block_size;
+            }
+
+            void read_blocks();
+
+            std::istream* stream;
+            size_t block_size;
+            bool is_valid;
+            PrefetchBlock blocks[PREFETCH_BLOCK_COUNT];
+            std::atomic<size_t> produced = 0;
+            std::atomic<size_t> consumed = 0;
+            std::atomic<bool> stopped = false;
+            std::exception_ptr exception;
+            std::thread thread;
+
+            // Only used by the consumer.
+            size_t current = 0;
+            bool has_block = false;
+            bool is_finished = false;
+            std::vector<char> overflow;
+        };
+
+        PrefetchContext::PrefetchContext(std::istream* stream, size_t block_size)
+            : stream(stream),
+              block_size(std::max<size_t>(block_size, 1)),
+              is_valid(stream && *stream)
+        {
+            for (auto& block : blocks)
+                block.buffer = std::make_unique<char[]>(2 * this->block_size);
+            if (is_valid)
+                thread = std::thread(&PrefetchContext::read_blocks, this);
+            else
+                is_finished = true;
+        }
+
+        PrefetchContext::~PrefetchContext()
+        {
+            if (thread.joinable())
+            {
+                stopped.store(true, std::memory_order_release);
+                // Wake the helper thread if it waits for a free block.
+                consumed.fetch_add(1, std::memory_order_release);
+                consumed.notify_one();
+                thread.join();
+            }
+        }
+
+        void PrefetchContext::read_blocks()
+        {
+            for (size_t n = 0;; ++n)
+            {
+                size_t c = consumed.load(std::memory_order_acquire);
+                while (n - c >= PREFETCH_BLOCK_COUNT)
+                {
+                    if (stopped.load(std::memory_order_acquire))
+                        return;
+                    consumed.wait(c, std::memory_order_acquire);
+                    c = consumed.load(std::memory_order_acquire);
+                }
+                if (stopped.load(std::memory_order_acquire))
+                    return;
+
+                auto& block = blocks[n % PREFETCH_BLOCK_COUNT];
+                try
+                {
+                    stream->read(data(block), std::streamsize(block_size));
+                    block.size = size_t(stream->gcount());
+                    block.is_last = !*stream;
+                }
+                catch (...)
+                {
+                    exception = std::current_exception();
+                    block.size = 0;
+                    block.is_last = true;
+                }
+
+                produced.store(n + 1, std::memory_order_release);
+                produced.notify_one();
+                if (block.is_last)
+                    return;
+            }
+        }
+    }
+
+    PrefetchingStreamBuffer::PrefetchingStreamBuffer() = default;
+
+    PrefetchingStreamBuffer::PrefetchingStreamBuffer(std::istream* stream,
+                                                     size_t block_size)
+        : context_(std::make_unique<Details::PrefetchContext>(stream, block_size))
+    {}
+
+    PrefetchingStreamBuffer::PrefetchingStreamBuffer(
+        PrefetchingStreamBuffer&& other) noexcept
+        : context_(std::move(other.context_)),
+          data_(other.data_),
+          offset_(other.offset_),
+          size_(other.size_),
+          bytes_moved_(other.bytes_moved_)
+    {
+        other.data_ = nullptr;
+        other.offset_ = other.size_ = 0;
+        other.bytes_moved_ = 0;
+    }
+
+    PrefetchingStreamBuffer&
+    PrefetchingStreamBuffer::operator=(PrefetchingStreamBuffer&& other) noexcept
+    {
+        context_ = std::move(other.context_);
+        data_ = other.data_;
+        offset_ = other.offset_;
+        size_ = other.size_;
+        bytes_moved_ = other.bytes_moved_;
+        other.data_ = nullptr;
+        other.offset_ = other.size_ = 0;
+        other.bytes_moved_ = 0;
+        return *this;
+    }
+
+    PrefetchingStreamBuffer::~PrefetchingStreamBuffer() = default;
+
+    PrefetchingStreamBuffer::operator bool() const
+    {
+        return context_ && context_->is_valid;
+    }
+
+    bool PrefetchingStreamBuffer::fill()
+    {
+        if (!context_ || context_->is_finished)
+            return false;
+
+        auto& ctx = *context_;
+        const auto next = ctx.has_block ? ctx.current + 1 : ctx.current;
+        auto produced = ctx.produced.load(std::memory_order_acquire);
+        while (produced <= next)
+        {
+            ctx.produced.wait(produced, std::memory_order_acquire);
+            produced = ctx.produced.load(std::memory_order_acquire);
+        }
+
+        auto& block = ctx.blocks[next % Details::PREFETCH_BLOCK_COUNT];
+        if (block.is_last)
+        {
+            ctx.is_finished = true;
+            if (ctx.exception)
+                std::rethrow_exception(ctx.exception);
+        }
+
+        if (block.size == 0)
+            return false;
+
+        auto* block_data = ctx.data(block);
+        const auto leftover = string();
+        auto& overflow = ctx.overflow;
+        const bool in_overflow = !overflow.empty() && data_ == overflow.data();
+        if (leftover.size() <= ctx.block_size)
+        {
+            // The common case: the unconsumed data fits in front of the
+            // new block.
+            auto* start = block_data - leftover.size();
+            std::copy(leftover.begin(), leftover.end(), start);
+            data_ = start;
+            size_ = leftover.size() + block.size;
+            bytes_moved_ += leftover.size();
+        }
+        else
+        {
+            // A token longer than a block. The new block is appended to
+            // the overflow buffer, which grows geometrically and keeps its
+            // capacity, so a long token is only copied a few times in total.
+            if (in_overflow)
+            {
+                overflow.erase(overflow.begin(),
+                               overflow.begin() + std::ptrdiff_t(offset_));
+                bytes_moved_ += offset_ != 0 ? leftover.size() : 0;
+            }
+            else
+            {
+                overflow.assign(leftover.begin(), leftover.end());
+                bytes_moved_ += leftover.size();
+            }
+            if (overflow.capacity() < overflow.size() + block.size)
+            {
+                bytes_moved_ += overflow.size();
+                overflow.reserve(std::max(2 * overflow.capacity(),
+                                          overflow.size() + block.size));
+            }
+            overflow.insert(overflow.end(), block_data, block_data + block.size);
+            data_ = overflow.data();
+            size_ = overflow.size();
+        }
+        offset_ = 0;
+
+        if (ctx.has_block)
+        {
+            ctx.consumed.store(ctx.current + 1, std::memory_order_release);
+            ctx.consumed.notify_one();
+        }
+        ctx.current = next;
+        ctx.has_block = true;
+        return true;
+    }
+}
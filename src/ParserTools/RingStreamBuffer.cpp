@@ -0,0 +1,278 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "ParserTools/RingStreamBuffer.hpp"
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <system_error>
+
+#ifdef _WIN32
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#else
+    #include <cerrno>
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <unistd.h>
+#endif
+
+namespace ParserTools
+{
+    namespace Details
+    {
+        /**
+         * @brief Owns @a capacity bytes of memory that are mapped twice,
+         *  at @a data and at @a data + @a capacity.
+         */
+        struct RingBufferContext
+        {
+            explicit RingBufferContext(size_t min_capacity);
+
+            ~RingBufferContext();
+
+            RingBufferContext(const RingBufferContext&) = delete;
+
+            RingBufferContext& operator=(const RingBufferContext&) = delete;
+
+            char* data = nullptr;
+            size_t capacity = 0;
+        };
+    }
+
+    namespace
+    {
+        [[noreturn]]
+        void throw_system_error(const std::string& message)
+        {
+        #ifdef _WIN32
+            throw std::system_error(int(GetLastError()), std::system_category(),
+                                    message);
+        #else
+            throw std::system_error(errno, std::generic_category(), message);
+        #endif
+        }
+
+        size_t get_mapping_granularity()
+        {
+        #ifdef _WIN32
+            SYSTEM_INFO info;
+            GetSystemInfo(&info);
+            return size_t(info.dwAllocationGranularity);
+        #else
+            return size_t(sysconf(_SC_PAGESIZE));
+        #endif
+        }
+
+    #ifdef _WIN32
+
+        char* map_ring(size_t capacity)
+        {
+            auto mapping = CreateFileMappingW(INVALID_HANDLE_VALUE, nullptr,
+                                              PAGE_READWRITE,
+                                              DWORD(uint64_t(capacity) >> 32),
+                                              DWORD(capacity & 0xFFFFFFFFu),
+                                              nullptr);
+            if (!mapping)
+                throw_system_error("Can't create the ring buffer");
+
+            // Find an address range that is large enough for both views,
+            // release it and map the views there. Another thread can grab
+            // the range in between, so retry a few times.
+            char* result = nullptr;
+            for (int attempt = 0; attempt < 16 && !result; ++attempt)
+            {
+                auto address = static_cast<char*>(
+                    VirtualAlloc(nullptr, 2 * capacity, MEM_RESERVE,
+                                 PAGE_NOACCESS));
+                if (!address)
+                    break;
+                VirtualFree(address, 0, MEM_RELEASE);
+
+                auto first = MapViewOfFileEx(mapping, FILE_MAP_ALL_ACCESS,
+                                             0, 0, capacity, address);
+                if (!first)
+                    continue;
+                auto second = MapViewOfFileEx(mapping, FILE_MAP_ALL_ACCESS,
+                                              0, 0, capacity,
+                                              address + capacity);
+                if (!second)
+                {
+                    UnmapViewOfFile(first);
+                    continue;
+                }
+                result = address;
+            }
+
+            // The views keep the mapping alive.
+            CloseHandle(mapping);
+            if (!result)
+                throw_system_error("Can't map the ring buffer");
+            return result;
+        }
+
+        void unmap_ring(char* data, size_t capacity)
+        {
+            UnmapViewOfFile(data + capacity);
+            UnmapViewOfFile(data);
+        }
+
+    #else
+
+        int create_shared_memory()
+        {
+        #ifdef __linux__
+            return memfd_create("ParserTools-ring", 0);
+        #else
+            static std::atomic<unsigned> counter = 0;
+            auto name = "/ParserTools-ring-" + std::to_string(getpid())
+                        + "-" + std::to_string(counter++);
+            auto fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+            if (fd != -1)
+                shm_unlink(name.c_str());
+            return fd;
+        #endif
+        }
+
+        char* map_ring(size_t capacity)
+        {
+            auto fd = create_shared_memory();
+            if (fd == -1)
+                throw_system_error("Can't create the ring buffer");
+            if (ftruncate(fd, off_t(capacity)) != 0)
+            {
+                auto error = errno;
+                close(fd);
+                errno = error;
+                throw_system_error("Can't resize the ring buffer");
+            }
+
+            // Reserve the address range for both views, then replace each
+            // half with a view of the shared memory.
+            auto address = mmap(nullptr, 2 * capacity, PROT_NONE,
+                                MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            auto data = static_cast<char*>(address);
+            if (address == MAP_FAILED
+                || mmap(data, capacity, PROT_READ | PROT_WRITE,
+                        MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED
+                || mmap(data + capacity, capacity, PROT_READ | PROT_WRITE,
+                        MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED)
+            {
+                auto error = errno;
+                if (address != MAP_FAILED)
+                    munmap(address, 2 * capacity);
+                close(fd);
+                errno = error;
+                throw_system_error("Can't map the ring buffer");
+            }
+
+            // The views keep the memory alive.
+            close(fd);
+            return data;
+        }
+
+        void unmap_ring(char* data, size_t capacity)
+        {
+            munmap(data, 2 * capacity);
+        }
+
+    #endif
+    }
+
+    namespace Details
+    {
+        RingBufferContext::RingBufferContext(size_t min_capacity)
+        {
+            auto granularity = get_mapping_granularity();
+            min_capacity = std::max<size_t>(min_capacity, 1);
+            capacity = (min_capacity + granularity - 1) / granularity
+                       * granularity;
+            data = map_ring(capacity);
+        }
+
+        RingBufferContext::~RingBufferContext()
+        {
+            unmap_ring(data, capacity);
+        }
+    }
+
+    RingStreamBuffer::RingStreamBuffer() = default;
+
+    RingStreamBuffer::RingStreamBuffer(std::istream* stream,
+                                       StreamReadMode mode,
+                                       size_t capacity)
+        : stream_(stream),
+          mode_(mode),
+          context_(std::make_unique<Details::RingBufferContext>(capacity)),
+          data_(context_->data),
+          capacity_(context_->capacity)
+    {}
+
+    RingStreamBuffer::RingStreamBuffer(RingStreamBuffer&& other) noexcept
+        : stream_(other.stream_),
+          mode_(other.mode_),
+          context_(std::move(other.context_)),
+          data_(other.data_),
+          offset_(other.offset_),
+          size_(other.size_),
+          capacity_(other.capacity_),
+          bytes_moved_(other.bytes_moved_)
+    {
+        other.stream_ = nullptr;
+        other.data_ = nullptr;
+        other.offset_ = other.size_ = other.capacity_ = 0;
+        other.bytes_moved_ = 0;
+    }
+
+    RingStreamBuffer& RingStreamBuffer::operator=(RingStreamBuffer&& other) noexcept
+    {
+        stream_ = other.stream_;
+        mode_ = other.mode_;
+        context_ = std::move(other.context_);
+        data_ = other.data_;
+        offset_ = other.offset_;
+        size_ = other.size_;
+        capacity_ = other.capacity_;
+        bytes_moved_ = other.bytes_moved_;
+        other.stream_ = nullptr;
+        other.data_ = nullptr;
+        other.offset_ = other.size_ = other.capacity_ = 0;
+        other.bytes_moved_ = 0;
+        return *this;
+    }
+
+    RingStreamBuffer::~RingStreamBuffer() = default;
+
+    bool RingStreamBuffer::fill()
+    {
+        if (!stream_ || !*stream_)
+            return false;
+
+        if (size_ == capacity_)
+        {
+            auto context = std::make_unique<Details::RingBufferContext>(
+                2 * capacity_);
+            std::copy(data_ + offset_, data_ + offset_ + size_, context->data);
+            context_ = std::move(context);
+            data_ = context_->data;
+            capacity_ = context_->capacity;
+            offset_ = 0;
+            bytes_moved_ += size_;
+        }
+
+        // The free part of the ring starts right after the unconsumed
+        // data, and thanks to the second view it is contiguous even when
+        // it wraps around.
+        auto bytes_read = Details::read_stream(*stream_, mode_,
+                                               data_ + offset_ + size_,
+                                               capacity_ - size_);
+        size_ += bytes_read;
+        return bytes_read != 0;
+    }
+}
@@ -26,6 +26,11 @@ namespace ParserTools
             XML_Parser parser = nullptr;
             ElementHandler* handler = nullptr;
             std::string buffer;
+            /**
+             * @brief Reused for every start tag, after the first few
+             *  elements it has room for all of them.
+             */
+            ElementHandler::Attributes attributes;
             bool ignore_whitespace = true;
         };
     }
@@ -50,17 +55,6 @@ namespace ParserTools
             context.buffer.clear();
         }
 
-        size_t count_attributes(const XML_Char** attributes)
-        {
-            size_t count = 0;
-            while (*attributes)
-            {
-                ++count;
-                attributes += 2;
-            }
-            return count;
-        }
-
         std::string get_error_message(XML_ParserStruct* parser)
         {
             auto error = XML_ErrorString(XML_GetErrorCode(parser));
@@ -75,8 +69,8 @@ namespace ParserTools
             auto& context = *static_cast<Details::ParserContext*>(user_data);
             handle_character_data_buffer(context);
 
-            std::vector<ElementHandler::Attribute> attrs;
-            attrs.reserve(count_attributes(attributes));
+            auto& attrs = context.attributes;
+            attrs.clear();
             while (*attributes)
             {
                 attrs.emplace_back(attributes[0], attributes[1]);
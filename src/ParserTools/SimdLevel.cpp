@@ -0,0 +1,110 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "ParserTools/SimdLevel.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include "SimdUtilities.hpp"
+
+#if PARSERTOOLS_X86 && defined(_MSC_VER) && !defined(__clang__)
+    #include <intrin.h>
+#endif
+
+namespace ParserTools
+{
+    namespace
+    {
+    #if PARSERTOOLS_X86 && defined(_MSC_VER) && !defined(__clang__)
+        SimdLevel detect_simd_level()
+        {
+            int info[4];
+            __cpuid(info, 0);
+            auto max_leaf = info[0];
+
+            __cpuid(info, 1);
+            bool has_sse2 = (info[3] & (1 << 26)) != 0;
+            bool has_popcnt = (info[2] & (1 << 23)) != 0;
+            bool has_osxsave = (info[2] & (1 << 27)) != 0;
+            if (!has_sse2)
+                return SimdLevel::SCALAR;
+            if (!has_osxsave || !has_popcnt || max_leaf < 7)
+                return SimdLevel::SSE2;
+
+            // The OS must save the YMM (and ZMM) registers on context switches.
+            auto xcr0 = _xgetbv(0);
+            if ((xcr0 & 0x6u) != 0x6u)
+                return SimdLevel::SSE2;
+
+            __cpuidex(info, 7, 0);
+            bool has_avx2 = (info[1] & (1 << 5)) != 0;
+            bool has_bmi = (info[1] & (1 << 3)) != 0;
+            bool has_bmi2 = (info[1] & (1 << 8)) != 0;
+            bool has_avx512 = (info[1] & (1 << 16)) != 0  // AVX512F
+                              && (info[1] & (1 << 30)) != 0  // AVX512BW
+                              && (info[1] & (1 << 31)) != 0; // AVX512VL
+            if (!has_avx2 || !has_bmi || !has_bmi2)
+                return SimdLevel::SSE2;
+            if (!has_avx512 || (xcr0 & 0xE6u) != 0xE6u)
+                return SimdLevel::AVX2;
+            return SimdLevel::AVX512;
+        }
+    #elif PARSERTOOLS_X86
+        SimdLevel detect_simd_level()
+        {
+            // __builtin_cpu_supports also checks that the OS supports
+            // the extended register state.
+            __builtin_cpu_init();
+            if (!__builtin_cpu_supports("sse2"))
+                return SimdLevel::SCALAR;
+            if (!__builtin_cpu_supports("avx2")
+                || !__builtin_cpu_supports("bmi")
+                || !__builtin_cpu_supports("bmi2")
+                || !__builtin_cpu_supports("popcnt"))
+            {
+                return SimdLevel::SSE2;
+            }
+            if (!__builtin_cpu_supports("avx512f")
+                || !__builtin_cpu_supports("avx512bw")
+                || !__builtin_cpu_supports("avx512vl"))
+            {
+                return SimdLevel::AVX2;
+            }
+            return SimdLevel::AVX512;
+        }
+    #else
+        SimdLevel detect_simd_level()
+        {
+            return SimdLevel::SCALAR;
+        }
+    #endif
+
+        std::atomic<SimdLevel>& current_simd_level()
+        {
+            static std::atomic<SimdLevel> level(detected_simd_level());
+            return level;
+        }
+    }
+
+    SimdLevel detected_simd_level()
+    {
+        static const SimdLevel level = detect_simd_level();
+        return level;
+    }
+
+    SimdLevel simd_level()
+    {
+        return current_simd_level().load(std::memory_order_relaxed);
+    }
+
+    SimdLevel set_simd_level(SimdLevel level)
+    {
+        level = std::min(level, detected_simd_level());
+        current_simd_level().store(level, std::memory_order_relaxed);
+        return level;
+    }
+}
@@ -0,0 +1,28 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    #define PARSERTOOLS_X86 1
+    #include <immintrin.h>
+#else
+    #define PARSERTOOLS_X86 0
+#endif
+
+// GCC and Clang only allow intrinsics for instruction sets that are enabled
+// for the function they are used in, MSVC allows them everywhere.
+#if PARSERTOOLS_X86 && (defined(__GNUC__) || defined(__clang__))
+    #define PARSERTOOLS_TARGET_SSE2 __attribute__((target("sse2")))
+    #define PARSERTOOLS_TARGET_AVX2 __attribute__((target("avx2,bmi,bmi2,popcnt")))
+    #define PARSERTOOLS_TARGET_AVX512 \
+        __attribute__((target("avx2,bmi,bmi2,popcnt,avx512f,avx512bw,avx512vl")))
+#else
+    #define PARSERTOOLS_TARGET_SSE2
+    #define PARSERTOOLS_TARGET_AVX2
+    #define PARSERTOOLS_TARGET_AVX512
+#endif
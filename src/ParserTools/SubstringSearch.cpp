@@ -0,0 +1,325 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "ParserTools/SubstringSearch.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <functional>
+#include <tuple>
+#include "ParserTools/ByteSearch.hpp"
+#include "ParserTools/SimdLevel.hpp"
+#include "ByteScanners.hpp"
+
+namespace ParserTools
+{
+    namespace
+    {
+        /**
+         * @brief Returns the start of the maximal suffix of @a needle and
+         *  its period, using either the normal or the reversed byte order.
+         */
+        template <typename Less>
+        std::pair<size_t, size_t> maximal_suffix(std::string_view needle, Less less)
+        {
+            // max_suffix is one less than the start of the suffix,
+            // it wraps around to SIZE_MAX at the start.
+            size_t max_suffix = SIZE_MAX;
+            size_t j = 0;
+            size_t k = 1;
+            size_t p = 1;
+            while (j + k < needle.size())
+            {
+                auto a = uint8_t(needle[j + k]);
+                auto b = uint8_t(needle[max_suffix + k]);
+                if (less(a, b))
+                {
+                    j += k;
+                    k = 1;
+                    p = j - max_suffix;
+                }
+                else if (a == b)
+                {
+                    if (k != p)
+                    {
+                        ++k;
+                    }
+                    else
+                    {
+                        j += p;
+                        k = 1;
+                    }
+                }
+                else
+                {
+                    max_suffix = j++;
+                    k = p = 1;
+                }
+            }
+            return {max_suffix + 1, p};
+        }
+
+        /**
+         * @brief Returns the critical factorization of @a needle: the
+         *  position where the right half starts, and the period of
+         *  the right half.
+         */
+        std::pair<size_t, size_t> critical_factorization(std::string_view needle)
+        {
+            auto [suffix, period] = maximal_suffix(needle, std::less<>());
+            auto [suffix_rev, period_rev] = maximal_suffix(needle, std::greater<>());
+            if (suffix_rev < suffix)
+                return {suffix, period};
+            return {suffix_rev, period_rev};
+        }
+
+        struct PrefilterResult
+        {
+            /**
+             * @brief The position of the match if found is true, otherwise
+             *  the position where the search must continue with Two-Way.
+             */
+            size_t pos;
+            bool found;
+        };
+
+        // The filter gives up when the candidates it has verified amount
+        // to more than this many bytes per input byte.
+        constexpr size_t MAX_VERIFIED_BYTES_PER_BYTE = 4;
+        constexpr size_t MIN_VERIFICATION_BUDGET = 256;
+
+        /**
+         * @brief Verifies the candidates in @a mask, where bit i
+         *  represents the position @a block + i.
+         *
+         * @return true if @a result has been set, either to a match or to
+         *  the position where the filter gave up.
+         */
+        bool check_candidates(std::string_view str, std::string_view needle,
+                              size_t block, uint64_t mask, size_t& verified,
+                              PrefilterResult& result)
+        {
+            while (mask)
+            {
+                auto pos = block + size_t(std::countr_zero(mask));
+                verified += needle.size();
+                if (verified > MAX_VERIFIED_BYTES_PER_BYTE * pos
+                               + MIN_VERIFICATION_BUDGET)
+                {
+                    result = {pos, false};
+                    return true;
+                }
+                if (std::memcmp(str.data() + pos + 1, needle.data() + 1,
+                                needle.size() - 2) == 0)
+                {
+                    result = {pos, true};
+                    return true;
+                }
+                mask &= mask - 1;
+            }
+            return false;
+        }
+
+    #if PARSERTOOLS_X86
+        PARSERTOOLS_TARGET_SSE2
+        PrefilterResult prefilter_sse2(std::string_view str, std::string_view needle)
+        {
+            const auto last_pos = needle.size() - 1;
+            const auto first = _mm_set1_epi8(needle[0]);
+            const auto last = _mm_set1_epi8(needle[last_pos]);
+            size_t verified = 0;
+            size_t i = 0;
+            PrefilterResult result = {};
+            for (; i + last_pos + 16 <= str.size(); i += 16)
+            {
+                auto f = _mm_cmpeq_epi8(first, Details::load_sse2(str.data() + i));
+                auto l = _mm_cmpeq_epi8(last, Details::load_sse2(str.data() + i + last_pos));
+                auto mask = uint32_t(_mm_movemask_epi8(_mm_and_si128(f, l)));
+                if (mask && check_candidates(str, needle, i, mask, verified, result))
+                    return result;
+            }
+            return {i, false};
+        }
+
+        PARSERTOOLS_TARGET_AVX2
+        PrefilterResult prefilter_avx2(std::string_view str, std::string_view needle)
+        {
+            const auto last_pos = needle.size() - 1;
+            const auto first = _mm256_set1_epi8(needle[0]);
+            const auto last = _mm256_set1_epi8(needle[last_pos]);
+            size_t verified = 0;
+            size_t i = 0;
+            PrefilterResult result = {};
+            for (; i + last_pos + 32 <= str.size(); i += 32)
+            {
+                auto f = _mm256_cmpeq_epi8(first, Details::load_avx2(str.data() + i));
+                auto l = _mm256_cmpeq_epi8(last, Details::load_avx2(str.data() + i + last_pos));
+                auto mask = uint32_t(_mm256_movemask_epi8(_mm256_and_si256(f, l)));
+                if (mask && check_candidates(str, needle, i, mask, verified, result))
+                    return result;
+            }
+            return {i, false};
+        }
+
+        PARSERTOOLS_TARGET_AVX512
+        PrefilterResult prefilter_avx512(std::string_view str, std::string_view needle)
+        {
+            const auto last_pos = needle.size() - 1;
+            const auto first = _mm512_set1_epi8(needle[0]);
+            const auto last = _mm512_set1_epi8(needle[last_pos]);
+            size_t verified = 0;
+            size_t i = 0;
+            PrefilterResult result = {};
+            for (; i + last_pos + 64 <= str.size(); i += 64)
+            {
+                auto f = _mm512_cmpeq_epi8_mask(first, _mm512_loadu_si512(str.data() + i));
+                auto l = _mm512_cmpeq_epi8_mask(last, _mm512_loadu_si512(str.data() + i + last_pos));
+                auto mask = uint64_t(f & l);
+                if (mask && check_candidates(str, needle, i, mask, verified, result))
+                    return result;
+            }
+            return {i, false};
+        }
+    #endif
+
+        PrefilterResult prefilter(std::string_view str, std::string_view needle)
+        {
+            switch (simd_level())
+            {
+        #if PARSERTOOLS_X86
+            case SimdLevel::AVX512:
+                return prefilter_avx512(str, needle);
+            case SimdLevel::AVX2:
+                return prefilter_avx2(str, needle);
+            case SimdLevel::SSE2:
+                return prefilter_sse2(str, needle);
+        #endif
+            default:
+                return {0, false};
+            }
+        }
+    }
+
+    SubstringSearcher::SubstringSearcher(std::string_view needle)
+        : needle_(needle)
+    {
+        if (needle_.size() < 2)
+            return;
+
+        std::tie(suffix_, period_) = critical_factorization(needle_);
+        is_periodic_ = std::memcmp(needle_.data(), needle_.data() + period_,
+                                   suffix_) == 0;
+        if (!is_periodic_)
+            period_ = std::max(suffix_, needle_.size() - suffix_) + 1;
+
+        // The shift that aligns the last occurrence of each byte in the
+        // needle with the last byte in the window. Shifts are capped at
+        // 255, shifting less than the maximum is always safe.
+        const auto n = needle_.size();
+        shifts_.fill(uint8_t(std::min<size_t>(n, UINT8_MAX)));
+        for (size_t i = 0; i < n; ++i)
+            shifts_[uint8_t(needle_[i])] = uint8_t(std::min<size_t>(n - i - 1, UINT8_MAX));
+    }
+
+    size_t SubstringSearcher::find(std::string_view str) const
+    {
+        if (needle_.empty())
+            return 0;
+        if (needle_.size() == 1)
+            return find_byte(str, needle_[0]);
+        if (needle_.size() > str.size())
+            return str.size();
+
+        if (needle_.size() <= SHORT_NEEDLE_SIZE)
+        {
+            auto [pos, found] = prefilter(str, needle_);
+            if (found)
+                return pos;
+            return pos + find_two_way(str.substr(pos));
+        }
+        return find_two_way(str);
+    }
+
+    size_t SubstringSearcher::find_two_way(std::string_view str) const
+    {
+        if (is_periodic_)
+            return find_two_way_periodic(str);
+
+        const auto n = needle_.size();
+        size_t j = 0;
+        while (j + n <= str.size())
+        {
+            if (auto shift = shifts_[uint8_t(str[j + n - 1])])
+            {
+                j += shift;
+                continue;
+            }
+
+            // The last byte matches, compare the right half.
+            auto i = suffix_;
+            while (i < n - 1 && needle_[i] == str[i + j])
+                ++i;
+
+            if (i < n - 1)
+            {
+                j += i - suffix_ + 1;
+                continue;
+            }
+
+            // Compare the left half backwards.
+            i = suffix_;
+            while (i != 0 && needle_[i - 1] == str[i - 1 + j])
+                --i;
+            if (i == 0)
+                return j;
+            j += period_;
+        }
+        return str.size();
+    }
+
+    size_t SubstringSearcher::find_two_way_periodic(std::string_view str) const
+    {
+        const auto n = needle_.size();
+        // The number of bytes at the start of the needle that are known
+        // to match after a shift by the period.
+        size_t memory = 0;
+        size_t j = 0;
+        while (j + n <= str.size())
+        {
+            if (size_t shift = shifts_[uint8_t(str[j + n - 1])])
+            {
+                // If the shift has not been capped, a mismatch in the
+                // last byte means that the period is broken.
+                if (memory && shift < period_ && shift != UINT8_MAX)
+                    shift = n - period_;
+                memory = 0;
+                j += shift;
+                continue;
+            }
+
+            auto i = std::max(suffix_, memory);
+            while (i < n - 1 && needle_[i] == str[i + j])
+                ++i;
+
+            if (i < n - 1)
+            {
+                j += i - suffix_ + 1;
+                memory = 0;
+                continue;
+            }
+
+            i = suffix_;
+            while (i > memory && needle_[i - 1] == str[i - 1 + j])
+                --i;
+            if (i <= memory)
+                return j;
+            j += period_;
+            memory = n - period_;
+        }
+        return str.size();
+    }
+}
@@ -0,0 +1,160 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "ParserTools/ThreadPool.hpp"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace ParserTools
+{
+    namespace Details
+    {
+        struct ThreadPoolContext
+        {
+            void run_tasks(const std::function<void(size_t)>& job_task,
+                           size_t job_task_count);
+
+            void work();
+
+            std::vector<std::thread> threads;
+            std::mutex mutex;
+            std::condition_variable job_started;
+            std::condition_variable job_finished;
+            bool stopped = false;
+
+            // The current job, protected by mutex. task is null when
+            // there is no job.
+            const std::function<void(size_t)>* task = nullptr;
+            size_t task_count = 0;
+            size_t job_id = 0;
+            size_t busy_workers = 0;
+            std::atomic<size_t> next_task = 0;
+            std::atomic<bool> failed = false;
+            std::exception_ptr exception;
+        };
+
+        void ThreadPoolContext::run_tasks(
+            const std::function<void(size_t)>& job_task,
+            size_t job_task_count)
+        {
+            while (!failed.load(std::memory_order_relaxed))
+            {
+                auto i = next_task.fetch_add(1, std::memory_order_relaxed);
+                if (i >= job_task_count)
+                    break;
+                try
+                {
+                    job_task(i);
+                }
+                catch (...)
+                {
+                    std::lock_guard lock(mutex);
+                    if (!exception)
+                        exception = std::current_exception();
+                    failed = true;
+                }
+            }
+        }
+
+        void ThreadPoolContext::work()
+        {
+            size_t last_job_id = 0;
+            while (true)
+            {
+                const std::function<void(size_t)>* job_task;
+                size_t job_task_count;
+                {
+                    std::unique_lock lock(mutex);
+                    job_started.wait(lock, [&]
+                    {
+                        return stopped || job_id != last_job_id;
+                    });
+                    if (stopped)
+                        return;
+                    last_job_id = job_id;
+                    // The job may already have finished.
+                    if (!task)
+                        continue;
+                    job_task = task;
+                    job_task_count = task_count;
+                    ++busy_workers;
+                }
+
+                run_tasks(*job_task, job_task_count);
+
+                std::lock_guard lock(mutex);
+                if (--busy_workers == 0)
+                    job_finished.notify_one();
+            }
+        }
+    }
+
+    ThreadPool::ThreadPool(size_t thread_count)
+        : context_(std::make_unique<Details::ThreadPoolContext>())
+    {
+        if (thread_count == 0)
+            thread_count = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+        context_->threads.reserve(thread_count - 1);
+        for (size_t i = 1; i < thread_count; ++i)
+            context_->threads.emplace_back(&Details::ThreadPoolContext::work,
+                                           context_.get());
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard lock(context_->mutex);
+            context_->stopped = true;
+        }
+        context_->job_started.notify_all();
+        for (auto& thread : context_->threads)
+            thread.join();
+    }
+
+    size_t ThreadPool::thread_count() const
+    {
+        return context_->threads.size() + 1;
+    }
+
+    void ThreadPool::run(size_t task_count,
+                         const std::function<void(size_t)>& task)
+    {
+        auto& ctx = *context_;
+        if (task_count == 0)
+            return;
+
+        {
+            std::lock_guard lock(ctx.mutex);
+            ctx.task = &task;
+            ctx.task_count = task_count;
+            ctx.next_task = 0;
+            ctx.failed = false;
+            ctx.exception = nullptr;
+            ++ctx.job_id;
+        }
+        if (task_count > 1)
+            ctx.job_started.notify_all();
+
+        ctx.run_tasks(task, task_count);
+
+        std::exception_ptr exception;
+        {
+            std::unique_lock lock(ctx.mutex);
+            ctx.job_finished.wait(lock, [&] { return ctx.busy_workers == 0; });
+            ctx.task = nullptr;
+            exception = std::exchange(ctx.exception, nullptr);
+        }
+        if (exception)
+            std::rethrow_exception(exception);
+    }
+}
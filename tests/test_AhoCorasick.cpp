@@ -0,0 +1,111 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "ParserTools/AhoCorasick.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+#include <random>
+#include <string>
+
+using namespace ParserTools;
+
+namespace
+{
+    PatternMatch find_naive(std::string_view str,
+                            const std::vector<std::string_view>& patterns)
+    {
+        PatternMatch best = {str.size(), str.size(), NO_PATTERN};
+        for (size_t i = 0; i < patterns.size(); ++i)
+        {
+            if (patterns[i].empty())
+                continue;
+            auto pos = str.find(patterns[i]);
+            if (pos == std::string_view::npos)
+                continue;
+            if (best.pattern == NO_PATTERN || pos < best.start
+                || (pos == best.start && pos + patterns[i].size() > best.end))
+            {
+                best = {pos, pos + patterns[i].size(), i};
+            }
+        }
+        return best;
+    }
+}
+
+TEST_CASE("AhoCorasickAutomaton finds the leftmost longest match")
+{
+    AhoCorasickAutomaton automaton({"bc", "abcd", "c", "abcdx", ""});
+    auto match = automaton.find("xabcdy");
+    REQUIRE(match.start == 1);
+    REQUIRE(match.end == 5);
+    REQUIRE(match.pattern == 1);
+
+    match = automaton.find("abxbcd");
+    REQUIRE(match.start == 3);
+    REQUIRE(match.end == 5);
+    REQUIRE(match.pattern == 0);
+
+    match = automaton.find("xyz");
+    REQUIRE(match.start == 3);
+    REQUIRE(match.end == 3);
+    REQUIRE(match.pattern == NO_PATTERN);
+}
+
+TEST_CASE("AhoCorasickAutomaton index_of")
+{
+    AhoCorasickAutomaton automaton({"\r\n", "--", "\r\n--", "--"});
+    REQUIRE(automaton.pattern_count() == 4);
+    REQUIRE(automaton.index_of("\r\n") == 0);
+    REQUIRE(automaton.index_of("--") == 1);
+    REQUIRE(automaton.index_of("\r\n--") == 2);
+    REQUIRE(automaton.index_of("\n--") == NO_PATTERN);
+    REQUIRE(automaton.index_of("-") == NO_PATTERN);
+    REQUIRE(automaton.index_of("") == NO_PATTERN);
+}
+
+TEST_CASE("AhoCorasickAutomaton on random strings")
+{
+    std::mt19937 rng(4321);
+    std::uniform_int_distribution<int> chars('a', 'd');
+    for (int n = 0; n < 200; ++n)
+    {
+        std::vector<std::string> strings(1 + rng() % 20);
+        for (auto& s : strings)
+        {
+            s.resize(1 + rng() % 6);
+            for (auto& c : s)
+                c = char(chars(rng));
+        }
+        std::vector<std::string_view> patterns(strings.begin(), strings.end());
+        AhoCorasickAutomaton automaton(patterns);
+
+        std::string str(rng() % 100, ' ');
+        for (auto& c : str)
+            c = char(chars(rng));
+
+        auto expected = find_naive(str, patterns);
+        auto match = automaton.find(str);
+        CAPTURE(str);
+        REQUIRE(match.start == expected.start);
+        REQUIRE(match.end == expected.end);
+        if (expected.pattern != NO_PATTERN)
+            REQUIRE(patterns[match.pattern] == patterns[expected.pattern]);
+    }
+}
+
+TEST_CASE("AhoCorasickAutomaton with many patterns")
+{
+    std::vector<std::string> strings;
+    for (int i = 0; i < 500; ++i)
+        strings.push_back("<" + std::to_string(i * 7919) + ">");
+    std::vector<std::string_view> patterns(strings.begin(), strings.end());
+    AhoCorasickAutomaton automaton(patterns);
+
+    auto match = automaton.find("<1><2><" + std::to_string(321 * 7919) + ">");
+    REQUIRE(match.start == 6);
+    REQUIRE(match.pattern == 321);
+}
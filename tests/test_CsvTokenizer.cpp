@@ -0,0 +1,146 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "ParserTools/CsvTokenizer.hpp"
+#include "ParserTools/SimdLevel.hpp"
+#include "ParserTools/StreamTokenizer.hpp"
+#include "ParserTools/StringTokenizer.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace ParserTools;
+
+namespace
+{
+    using Records = std::vector<std::vector<std::string>>;
+
+    template <typename Tokenizer>
+    Records read_tokens(Tokenizer&& tokenizer, char quote = '"')
+    {
+        Records records(1);
+        std::string buffer;
+        for (auto item : tokenizer)
+        {
+            records.back().emplace_back(unquote_csv_field(item.string(),
+                                                          buffer, quote));
+            if (FindCsvDelimiter::is_record_end(item.token()))
+                records.emplace_back();
+        }
+        records.pop_back();
+        return records;
+    }
+
+    Records read_records(std::string_view str, char separator = ',')
+    {
+        return read_tokens(tokenize(str, FindCsvDelimiter(separator)));
+    }
+}
+
+TEST_CASE("Test CSV tokenization")
+{
+    auto records = read_records("a,\"b,c\",d\r\n\"e\"\"f\",,\"\"\ng");
+    REQUIRE(records == Records{{"a", "b,c", "d"}, {"e\"f", "", ""}, {"g"}});
+}
+
+TEST_CASE("Test CSV tokenization with line breaks in quotes")
+{
+    auto records = read_records("\"a\nb\",\"c\r\nd\"\r\"\"\"\"");
+    REQUIRE(records == Records{{"a\nb", "c\r\nd"}, {"\""}});
+}
+
+TEST_CASE("Test TSV tokenization")
+{
+    auto records = read_records("a\tb,c\t\"d\te\"\n", '\t');
+    REQUIRE(records == Records{{"a", "b,c", "d\te"}});
+}
+
+TEST_CASE("Test CSV tokenization with other quote")
+{
+    auto tokenizer = tokenize("'a,b',c", FindCsvDelimiter(',', '\''));
+    REQUIRE(read_tokens(tokenizer, '\'') == Records{{"a,b", "c"}});
+}
+
+TEST_CASE("Test unquote_csv_field")
+{
+    std::string buffer;
+    std::string_view field = "\"abc\"";
+    auto value = unquote_csv_field(field, buffer);
+    REQUIRE(value == "abc");
+    REQUIRE(value.data() == field.data() + 1);
+    REQUIRE(unquote_csv_field("abc", buffer) == "abc");
+    REQUIRE(unquote_csv_field("\"", buffer) == "\"");
+    REQUIRE(unquote_csv_field("\"\"\"\"\"\"", buffer) == "\"\"");
+    REQUIRE(unquote_csv_field("\"a\"\"b\"\"\"", buffer) == "a\"b\"");
+    REQUIRE(buffer == "a\"b\"");
+}
+
+TEST_CASE("Test CSV delimiters at all SIMD levels")
+{
+    std::mt19937 engine(5);
+    std::uniform_int_distribution<size_t> char_dist(0, 7);
+    const char chars[] = {'a', 'b', ',', '"', '\n', '\r', '\0', 'x'};
+    for (size_t size = 0; size < 300; ++size)
+    {
+        std::string str;
+        for (size_t i = 0; i < size; ++i)
+        {
+            // Mostly text to get long fields.
+            auto c = chars[char_dist(engine)];
+            str.push_back(char_dist(engine) < 5 ? 'a' : c);
+        }
+        for (char separator : {',', '\0'})
+        {
+            set_simd_level(SimdLevel::SCALAR);
+            auto expected = FindCsvDelimiter(separator)(str);
+            for (auto level : {SimdLevel::SSE2, SimdLevel::AVX2,
+                               SimdLevel::AVX512})
+            {
+                if (level > detected_simd_level())
+                    break;
+                set_simd_level(level);
+                CAPTURE(int(level), str, int(separator));
+                REQUIRE(FindCsvDelimiter(separator)(str) == expected);
+            }
+        }
+    }
+    set_simd_level(detected_simd_level());
+}
+
+TEST_CASE("Test CSV tokenization of a stream")
+{
+    // Long quoted fields make sure fields cross the buffer boundaries.
+    std::string csv;
+    Records expected;
+    std::mt19937 engine(9);
+    std::uniform_int_distribution<size_t> length_dist(0, 3000);
+    for (int i = 0; i < 200; ++i)
+    {
+        auto& record = expected.emplace_back();
+        for (int j = 0; j < 3; ++j)
+        {
+            std::string value(length_dist(engine), 'v');
+            if (!value.empty())
+                value[value.size() / 2] = "\",\n\r"[size_t(i + j) % 4];
+            record.push_back(value);
+            if (j != 0)
+                csv += ',';
+            csv += '"';
+            for (auto c : value)
+                csv += c == '"' ? "\"\"" : std::string(1, c);
+            csv += '"';
+        }
+        csv += i % 2 ? "\n" : "\r\n";
+    }
+
+    REQUIRE(read_records(csv) == expected);
+    std::istringstream stream(csv);
+    REQUIRE(read_tokens(tokenize(stream, FindCsvDelimiter())) == expected);
+}
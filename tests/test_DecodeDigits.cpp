@@ -0,0 +1,153 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "ParserTools/DecodeDigits.hpp"
+#include "ParserTools/SimdLevel.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace ParserTools;
+
+namespace
+{
+    using DecodeFunc = ParseResult<size_t> (*)(std::string_view,
+                                               std::span<uint8_t>);
+
+    struct Decoded
+    {
+        std::vector<uint8_t> bytes;
+        size_t size = 0;
+        std::errc error = {};
+
+        bool operator==(const Decoded&) const = default;
+    };
+
+    Decoded decode(DecodeFunc func, std::string_view str)
+    {
+        Decoded result;
+        result.bytes.resize(str.size());
+        auto r = func(str, result.bytes);
+        result.bytes.resize(r ? r.value : 0);
+        result.size = r.size;
+        result.error = r.error;
+        return result;
+    }
+
+    void check_levels(DecodeFunc func, std::string_view str)
+    {
+        set_simd_level(SimdLevel::SCALAR);
+        auto expected = decode(func, str);
+        for (auto level : {SimdLevel::SSE2, SimdLevel::AVX2, SimdLevel::AVX512})
+        {
+            if (level > detected_simd_level())
+                break;
+            set_simd_level(level);
+            CAPTURE(int(level), str);
+            REQUIRE(decode(func, str) == expected);
+        }
+        set_simd_level(detected_simd_level());
+    }
+
+    std::string random_digits(std::mt19937& engine, std::string_view digits,
+                              size_t size)
+    {
+        std::uniform_int_distribution<size_t> dist(0, digits.size() - 1);
+        std::string result;
+        for (size_t i = 0; i < size; ++i)
+            result.push_back(digits[dist(engine)]);
+        return result;
+    }
+}
+
+TEST_CASE("Test decode_hex")
+{
+    auto result = decode(decode_hex, "00ff7F80a1B2c3D4");
+    REQUIRE(result.error == std::errc());
+    REQUIRE(result.size == 16);
+    REQUIRE(result.bytes == std::vector<uint8_t>{0x00, 0xFF, 0x7F, 0x80,
+                                                 0xA1, 0xB2, 0xC3, 0xD4});
+    REQUIRE(decode(decode_hex, "").bytes.empty());
+
+    result = decode(decode_hex, "0123456789abcdefg0");
+    REQUIRE(result.error == std::errc::invalid_argument);
+    REQUIRE(result.size == 16);
+
+    result = decode(decode_hex, "abc");
+    REQUIRE(result.error == std::errc::invalid_argument);
+    REQUIRE(result.size == 3);
+}
+
+TEST_CASE("Test decode_hex with too small output")
+{
+    uint8_t bytes[2];
+    auto result = decode_hex("aabbcc", bytes);
+    REQUIRE(result.error == std::errc::result_out_of_range);
+}
+
+TEST_CASE("Test decode_binary")
+{
+    auto result = decode(decode_binary, "100000010111111100000001");
+    REQUIRE(result.error == std::errc());
+    REQUIRE(result.bytes == std::vector<uint8_t>{0x81, 0x7F, 0x01});
+
+    result = decode(decode_binary, "1000000101111121");
+    REQUIRE(result.error == std::errc::invalid_argument);
+    REQUIRE(result.size == 14);
+
+    result = decode(decode_binary, "1010");
+    REQUIRE(result.error == std::errc::invalid_argument);
+    REQUIRE(result.size == 4);
+}
+
+TEST_CASE("Test decode_octal")
+{
+    // 0o77777777 is 0xFFFFFF, 0o01234567 is 0x053977.
+    auto result = decode(decode_octal, "7777777701234567");
+    REQUIRE(result.error == std::errc());
+    REQUIRE(result.bytes == std::vector<uint8_t>{0xFF, 0xFF, 0xFF,
+                                                 0x05, 0x39, 0x77});
+
+    result = decode(decode_octal, "01234568");
+    REQUIRE(result.error == std::errc::invalid_argument);
+    REQUIRE(result.size == 7);
+
+    result = decode(decode_octal, "0123");
+    REQUIRE(result.error == std::errc::invalid_argument);
+    REQUIRE(result.size == 4);
+}
+
+TEST_CASE("Test decoding with all SIMD levels")
+{
+    std::mt19937 engine(3);
+    for (size_t size = 0; size < 200; ++size)
+    {
+        auto hex = random_digits(engine, "0123456789abcdefABCDEF", size);
+        check_levels(decode_hex, hex);
+        auto octal = random_digits(engine, "01234567", size);
+        check_levels(decode_octal, octal);
+        auto binary = random_digits(engine, "01", size);
+        check_levels(decode_binary, binary);
+        if (size == 0)
+            continue;
+        auto pos = std::uniform_int_distribution<size_t>(0, size - 1)(engine);
+        for (char c : {'g', 'G', '/', ':', '@', '`', '8', '2', '\0', '\xC1', '_'})
+        {
+            auto invalid = hex;
+            invalid[pos] = c;
+            check_levels(decode_hex, invalid);
+            invalid = octal;
+            invalid[pos] = c;
+            check_levels(decode_octal, invalid);
+            invalid = binary;
+            invalid[pos] = c;
+            check_levels(decode_binary, invalid);
+        }
+    }
+}
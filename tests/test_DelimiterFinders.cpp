@@ -6,8 +6,16 @@
 // License text is included with the source distribution.
 //****************************************************************************
 #include "ParserTools/DelimiterFinders.hpp"
+#include "ParserTools/SimdLevel.hpp"
+#include "ParserTools/StreamTokenizer.hpp"
+#include "ParserTools/StringTokenizer.hpp"
 #include <catch2/catch_test_macros.hpp>
 
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
 using namespace ParserTools;
 
 TEST_CASE("Test FindNewline")
@@ -20,3 +28,282 @@ TEST_CASE("Test FindNewline")
     REQUIRE(FindNewline()("0123456\n89ABCDEF") == P(7, 8));
     REQUIRE(FindNewline()("\r ") == P(0, 1));
 }
+
+namespace
+{
+    std::vector<SimdLevel> get_supported_simd_levels()
+    {
+        std::vector<SimdLevel> result;
+        for (auto level : {SimdLevel::SCALAR, SimdLevel::SSE2,
+                           SimdLevel::AVX2, SimdLevel::AVX512})
+        {
+            if (level <= detected_simd_level())
+                result.push_back(level);
+        }
+        return result;
+    }
+
+    template <typename Finder>
+    void check_all_simd_levels(const std::string& str, Finder finder)
+    {
+        set_simd_level(SimdLevel::SCALAR);
+        auto expected = finder(str);
+        for (auto level : get_supported_simd_levels())
+        {
+            set_simd_level(level);
+            CAPTURE(int(level), str.size());
+            REQUIRE(finder(str) == expected);
+        }
+        set_simd_level(detected_simd_level());
+    }
+}
+
+TEST_CASE("FindChar and FindNewline agree on all SIMD levels")
+{
+    for (size_t size = 0; size < 150; ++size)
+    {
+        std::string str(size, 'a');
+        check_all_simd_levels(str, FindChar('\n'));
+        check_all_simd_levels(str, FindNewline());
+        for (size_t i = 0; i < size; i += 7)
+        {
+            str[i] = '\r';
+            if (i + 1 < size)
+                str[i + 1] = '\n';
+            check_all_simd_levels(str, FindChar('\n'));
+            check_all_simd_levels(str, FindChar('\r'));
+            check_all_simd_levels(str, FindNewline());
+            str.assign(size, 'a');
+        }
+    }
+}
+
+TEST_CASE("FindChar with NUL byte")
+{
+    using P = std::pair<size_t, size_t>;
+    std::string str(70, 'x');
+    str[65] = '\0';
+    REQUIRE(FindChar('\0')(str) == P(65, 66));
+    REQUIRE(FindChar('\0')(std::string_view(str).substr(0, 65)) == P(65, 65));
+}
+
+TEST_CASE("Test FindAnyOf")
+{
+    using P = std::pair<size_t, size_t>;
+
+    REQUIRE(FindAnyOf(" \t,;|")("abc;|def") == P(3, 4));
+    REQUIRE(FindAnyOf(" \t,;|")("|def") == P(0, 1));
+    REQUIRE(FindAnyOf(" \t,;|")("abc") == P(3, 3));
+    REQUIRE(FindAnyOf("")("abc") == P(3, 3));
+}
+
+TEST_CASE("Test FindSequenceOf")
+{
+    using P = std::pair<size_t, size_t>;
+
+    REQUIRE(FindSequenceOf(" \t,;|")("abc;| \tdef") == P(3, 7));
+    REQUIRE(FindSequenceOf(" \t,;|")("abc;") == P(3, 4));
+    REQUIRE(FindSequenceOf(" \t,;|")("abc") == P(3, 3));
+    REQUIRE(FindSequenceOf("")("abc") == P(3, 3));
+}
+
+TEST_CASE("FindAnyOf and FindSequenceOf agree on all SIMD levels")
+{
+    // The last set needs both pairs of nibble tables.
+    for (std::string_view chars : {" \t,;|", "\xFF\x80",
+                                   "\x01\x12\x23\x34\x45\x56\x67\x78\x89\x9A"})
+    {
+        for (size_t size = 0; size < 150; size += 3)
+        {
+            std::string str(size, 'a');
+            check_all_simd_levels(str, FindAnyOf(chars));
+            for (size_t i = 0; i < size; i += 5)
+            {
+                str[i] = chars[i % chars.size()];
+                str[size - 1 - i / 2] = chars[(i + 1) % chars.size()];
+                check_all_simd_levels(str, FindAnyOf(chars));
+                check_all_simd_levels(str, FindSequenceOf(chars));
+            }
+            std::string all(size, chars[0]);
+            check_all_simd_levels(all, FindSequenceOf(chars));
+        }
+    }
+}
+
+TEST_CASE("ByteSet contains exactly its members")
+{
+    std::string chars;
+    for (int i = 0; i < 256; i += 3)
+        chars.push_back(char(i));
+    ByteSet set(chars);
+    std::string all;
+    for (int i = 0; i < 256; ++i)
+    {
+        REQUIRE(set.contains(char(i)) == (i % 3 == 0));
+        all.push_back(char(i));
+    }
+    for (auto level : get_supported_simd_levels())
+    {
+        set_simd_level(level);
+        for (size_t i = 0; i < all.size(); ++i)
+        {
+            auto expected = i % 3 == 0 ? i : i + 3 - i % 3;
+            REQUIRE(find_byte_in(std::string_view(all).substr(i), set) + i
+                    == std::min(expected, all.size()));
+            expected = i % 3 == 0 ? i + 1 : i;
+            REQUIRE(find_byte_not_in(std::string_view(all).substr(i), set) + i
+                    == expected);
+        }
+    }
+    set_simd_level(detected_simd_level());
+}
+
+TEST_CASE("Test FindWhitespace")
+{
+    using P = std::pair<size_t, size_t>;
+
+    REQUIRE(FindWhitespace()("abc \t\r\n\v\fdef") == P(3, 9));
+    REQUIRE(FindWhitespace()("abc") == P(3, 3));
+    REQUIRE(FindWhitespace()("\xA0\x85 x") == P(2, 3));
+    REQUIRE(FindWhitespace()("a\x1C\x1D\x1E\x1F b") == P(5, 6));
+    std::string long_str(100, 'x');
+    long_str.replace(70, 3, " \t ");
+    check_all_simd_levels(long_str, FindWhitespace());
+}
+
+TEST_CASE("Test FindUnicodeWhitespace")
+{
+    using P = std::pair<size_t, size_t>;
+
+    REQUIRE(FindUnicodeWhitespace()("abc def") == P(3, 4));
+    REQUIRE(FindUnicodeWhitespace()("abc") == P(3, 3));
+    // U+00A0 NO-BREAK SPACE and U+3000 IDEOGRAPHIC SPACE
+    REQUIRE(FindUnicodeWhitespace()("abc\xC2\xA0 \xE3\x80\x80" "def") == P(3, 9));
+    // U+00E9 and U+2000 EN QUAD
+    REQUIRE(FindUnicodeWhitespace()("\xC3\xA9\xE2\x80\x80x") == P(2, 5));
+    // U+2010 HYPHEN is not whitespace, U+205F is.
+    REQUIRE(FindUnicodeWhitespace()("\xE2\x80\x90\xE2\x81\x9F") == P(3, 6));
+    // Truncated encodings
+    REQUIRE(FindUnicodeWhitespace()("a\xE2\x80") == P(3, 3));
+    REQUIRE(FindUnicodeWhitespace()("a\xC2") == P(2, 2));
+    // Only continuation bytes can follow a lead byte.
+    REQUIRE(FindUnicodeWhitespace()("\xE2\x80" "Ab") == P(4, 4));
+}
+
+namespace
+{
+    template <typename Tokenizer>
+    std::vector<std::string> get_matching_lines(Tokenizer&& tokenizer)
+    {
+        std::vector<std::string> result;
+        for (auto item : tokenizer)
+        {
+            if (item.token().empty())
+                break;
+            result.emplace_back(item.token());
+        }
+        return result;
+    }
+
+    std::vector<std::string> expected_matching_lines(std::string_view str,
+                                                     std::string_view substring)
+    {
+        std::vector<std::string> result;
+        for (auto item : tokenize(str, FindAnyOf("\r\n")))
+        {
+            if (item.string().find(substring) != std::string_view::npos)
+                result.emplace_back(item.string());
+        }
+        return result;
+    }
+}
+
+TEST_CASE("Test FindLineContaining")
+{
+    std::string_view str = "info: a\nERROR: b\r\nwarning\rERROR ERROR\n\nERROR";
+    REQUIRE(get_matching_lines(tokenize(str, FindLineContaining("ERROR")))
+            == std::vector<std::string>{"ERROR: b", "ERROR ERROR", "ERROR"});
+    REQUIRE(get_matching_lines(tokenize(str, FindLineContaining("a")))
+            == std::vector<std::string>{"info: a", "warning"});
+    REQUIRE(get_matching_lines(tokenize(str, FindLineContaining("x"))).empty());
+    REQUIRE(get_matching_lines(tokenize(str, FindLineContaining(""))).empty());
+}
+
+TEST_CASE("Test FindLineContaining with a stream")
+{
+    std::string str;
+    for (int i = 0; i < 20000; ++i)
+    {
+        str += "line " + std::to_string(i);
+        if (i % 97 == 0)
+            str += " customer=12345";
+        if (i % 1000 == 0)
+            str += std::string(100000, '.');
+        str += i % 3 ? "\n" : "\r\n";
+    }
+    auto expected = expected_matching_lines(str, "customer=12345");
+    REQUIRE(expected.size() == 207);
+    REQUIRE(get_matching_lines(tokenize(str, FindLineContaining("customer=12345")))
+            == expected);
+    std::istringstream stream(str);
+    REQUIRE(get_matching_lines(tokenize(stream, FindLineContaining("customer=12345")))
+            == expected);
+}
+
+TEST_CASE("Test FindLineContaining with short lines around buffer refills")
+{
+    std::mt19937 engine(17);
+    std::uniform_int_distribution<size_t> length(0, 40);
+    std::uniform_int_distribution<int> kind(0, 9);
+    for (int run = 0; run < 20; ++run)
+    {
+        std::string str;
+        while (str.size() < 3 * DEFAULT_STREAM_BUFFER_CAPACITY)
+        {
+            str.append(length(engine), 't');
+            if (kind(engine) < 3)
+                str += "MARKER";
+            str.append(length(engine), 'b');
+            auto k = kind(engine);
+            str += k < 6 ? "\n" : k < 8 ? "\r\n" : "\r";
+        }
+        auto expected = get_matching_lines(tokenize(str, FindLineContaining("MARKER")));
+        REQUIRE(expected == expected_matching_lines(str, "MARKER"));
+        std::istringstream stream(str);
+        REQUIRE(get_matching_lines(tokenize(stream, FindLineContaining("MARKER")))
+                == expected);
+    }
+}
+
+TEST_CASE("FindLineContaining doesn't search a line again after a refill")
+{
+    using P = std::pair<size_t, size_t>;
+    FindLineContaining finder("needle");
+
+    std::string str = "abc\n" + std::string(100, 'x');
+    REQUIRE(finder(str) == P(104, 104));
+    auto pos = finder.resume_position(str, str.size());
+    REQUIRE(pos == 4);
+
+    // Only the last five bytes of the previous search are searched
+    // again, the needle in the first part of the line isn't found.
+    str.replace(10, 6, "needle");
+    str += "yyynee";
+    REQUIRE(finder(std::string_view(str).substr(pos)) == P(106, 106));
+
+    // A needle that straddles the refill is found.
+    pos = finder.resume_position(str, str.size());
+    REQUIRE(pos == 4);
+    str += "dle and more";
+    auto [s, e] = finder(std::string_view(str).substr(pos));
+    REQUIRE(std::string_view(str).substr(pos + s, e - s).ends_with("needle and more"));
+
+    // A matching line that reaches the end of the string is completed
+    // by searching for the line break after it.
+    auto line_start = pos + s;
+    pos = finder.resume_position(str, line_start);
+    REQUIRE(pos == line_start);
+    str += " still\nnext";
+    REQUIRE(finder(std::string_view(str).substr(pos))
+            == P(0, str.size() - 5 - pos));
+}
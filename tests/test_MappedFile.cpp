@@ -0,0 +1,99 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "ParserTools/MappedFile.hpp"
+#include "ParserTools/DelimiterFinders.hpp"
+#include "ParserTools/StreamTokenizer.hpp"
+#include "ParserTools/StringTokenizer.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace ParserTools;
+
+namespace
+{
+    struct TemporaryFile
+    {
+        explicit TemporaryFile(const std::string& contents)
+            : path(std::filesystem::temp_directory_path()
+                   / ("ParserToolsTest-" + std::to_string(contents.size()) + ".txt"))
+        {
+            std::ofstream file(path, std::ios::binary);
+            file << contents;
+        }
+
+        ~TemporaryFile()
+        {
+            std::error_code ec;
+            std::filesystem::remove(path, ec);
+        }
+
+        std::filesystem::path path;
+    };
+
+    std::string make_lines(size_t count)
+    {
+        std::string result;
+        for (size_t i = 0; i < count; ++i)
+            result += "Line number " + std::to_string(i) + "\n";
+        return result;
+    }
+}
+
+TEST_CASE("Split a mapped file")
+{
+    auto contents = make_lines(1000);
+    TemporaryFile tmp(contents);
+    MappedFile file(tmp.path);
+    REQUIRE(file);
+    REQUIRE(!file.is_windowed());
+    REQUIRE(file.file_size() == contents.size());
+    REQUIRE(file.string() == contents);
+    auto lines = split(file.string(), FindNewline());
+    REQUIRE(lines.size() == 1001);
+    REQUIRE(lines[999] == "Line number 999");
+}
+
+TEST_CASE("Tokenize a mapped file in a sliding window")
+{
+    auto contents = make_lines(10000);
+    contents += std::string(20000, 'x') + "\nlast";
+    TemporaryFile tmp(contents);
+    MappedFileOptions options;
+    options.max_mapping_size = 4096;
+    MappedFile file(tmp.path, options);
+    REQUIRE(file.is_windowed());
+    REQUIRE(file.string().size() < contents.size());
+
+    std::vector<std::string> lines;
+    for (auto item : tokenize(std::move(file), FindNewline()))
+        lines.emplace_back(item.string());
+    REQUIRE(lines.size() == 10002);
+    REQUIRE(lines[0] == "Line number 0");
+    REQUIRE(lines[9999] == "Line number 9999");
+    REQUIRE(lines[10000] == std::string(20000, 'x'));
+    REQUIRE(lines[10001] == "last");
+}
+
+TEST_CASE("Tokenize an empty mapped file")
+{
+    TemporaryFile tmp("");
+    MappedFile file(tmp.path);
+    REQUIRE(file.string().empty());
+    int count = 0;
+    for ([[maybe_unused]] auto item : tokenize(std::move(file), FindNewline()))
+        ++count;
+    REQUIRE(count == 1);
+}
+
+TEST_CASE("Open a file that doesn't exist")
+{
+    REQUIRE_THROWS(MappedFile("/this/file/does/not/exist.txt"));
+}
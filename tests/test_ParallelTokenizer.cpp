@@ -0,0 +1,114 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "ParserTools/ParallelTokenizer.hpp"
+#include "ParserTools/DelimiterFinders.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <stdexcept>
+
+using namespace ParserTools;
+
+namespace
+{
+    std::string make_text(size_t count)
+    {
+        std::string result;
+        const char* separators[] = {"\n", "\r\n", " ", ", ", "<>", "  ,"};
+        for (size_t i = 0; i < count; ++i)
+        {
+            result += std::string(i % 13, char('a' + i % 26));
+            result += separators[(i * 7) % 6];
+        }
+        return result;
+    }
+
+    template <typename FindDelimiterFunc>
+    std::vector<std::string_view>
+    get_tokens(std::string_view str, FindDelimiterFunc finder)
+    {
+        std::vector<std::string_view> result;
+        for (auto item : tokenize(str, finder))
+            result.push_back(item.string());
+        return result;
+    }
+
+    template <typename FindDelimiterFunc>
+    void check_parallel_tokens(ThreadPool& pool, std::string_view str,
+                               FindDelimiterFunc finder)
+    {
+        auto expected = get_tokens(str, finder);
+        for (size_t chunk_size : {1, 2, 3, 10, 100, 1000, 100000})
+        {
+            CAPTURE(chunk_size);
+            REQUIRE(parallel_get_tokens(pool, str, finder, chunk_size) == expected);
+        }
+    }
+}
+
+TEST_CASE("ThreadPool: run all tasks")
+{
+    ThreadPool pool(4);
+    REQUIRE(pool.thread_count() == 4);
+    for (size_t task_count : {0, 1, 3, 1000})
+    {
+        std::vector<std::atomic<int>> calls(task_count);
+        pool.run(task_count, [&](size_t i) { ++calls[i]; });
+        for (auto& call : calls)
+            REQUIRE(call == 1);
+    }
+}
+
+TEST_CASE("ThreadPool: exceptions are rethrown")
+{
+    ThreadPool pool(3);
+    REQUIRE_THROWS(pool.run(100, [](size_t i)
+    {
+        if (i == 50)
+            throw std::runtime_error("task failed");
+    }));
+    std::atomic<int> count = 0;
+    pool.run(10, [&](size_t) { ++count; });
+    REQUIRE(count == 10);
+}
+
+TEST_CASE("parallel_get_tokens gives the same tokens as tokenize")
+{
+    ThreadPool pool(4);
+    auto text = make_text(2000);
+    check_parallel_tokens(pool, text, FindNewline());
+    check_parallel_tokens(pool, text, FindChar(','));
+    check_parallel_tokens(pool, text, FindSequenceOf(" ,"));
+    check_parallel_tokens(pool, text, FindWhitespace());
+    check_parallel_tokens(pool, text, FindSubstring("<>"));
+    check_parallel_tokens(pool, "", FindNewline());
+    check_parallel_tokens(pool, "\n", FindNewline());
+    check_parallel_tokens(pool, "abc", FindNewline());
+}
+
+TEST_CASE("parallel_tokenize calls the callback for each chunk")
+{
+    ThreadPool pool(4);
+    auto text = make_text(1000);
+    auto chunks = get_tokenizer_chunks(text, FindNewline(), 100);
+    REQUIRE(chunks.size() > 1);
+    std::vector<std::vector<std::string_view>> tokens(chunks.size());
+    parallel_tokenize(pool, text, FindNewline(), [&](size_t i, auto tokenizer)
+    {
+        for (auto item : tokenizer)
+            tokens[i].push_back(item.string());
+    }, 100);
+
+    std::vector<std::string_view> all_tokens;
+    for (size_t i = 0; i < chunks.size(); ++i)
+    {
+        REQUIRE(!chunks[i].empty());
+        all_tokens.insert(all_tokens.end(), tokens[i].begin(), tokens[i].end());
+    }
+    REQUIRE(all_tokens == get_tokens(text, FindNewline()));
+}
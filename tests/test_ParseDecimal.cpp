@@ -0,0 +1,111 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "ParserTools/ParseDecimal.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+#include <random>
+#include <string>
+
+using namespace ParserTools;
+
+TEST_CASE("Test parse_decimal")
+{
+    REQUIRE(parse_decimal<int64_t, 4>("12345.6789") == 123456789);
+    REQUIRE(parse_decimal<int64_t, 4>("-1.5") == -15000);
+    REQUIRE(parse_decimal<int64_t, 4>("+7") == 70000);
+    REQUIRE(parse_decimal<int64_t, 4>("7.") == 70000);
+    REQUIRE(parse_decimal<int64_t, 4>("0.0001") == 1);
+    REQUIRE(parse_decimal<int64_t, 4>("1_000.25_5") == 10002550);
+    REQUIRE(parse_decimal<int64_t, 0>("42") == 42);
+    REQUIRE(parse_decimal<int64_t, 2>("1.2300000") == 123);
+    REQUIRE_FALSE(parse_decimal<int64_t, 4>(""));
+    REQUIRE_FALSE(parse_decimal<int64_t, 4>("-"));
+    REQUIRE_FALSE(parse_decimal<int64_t, 4>(".5"));
+    REQUIRE_FALSE(parse_decimal<int64_t, 4>("1._5"));
+    REQUIRE_FALSE(parse_decimal<int64_t, 4>("1.5_"));
+    REQUIRE_FALSE(parse_decimal<int64_t, 4>("1e3"));
+    REQUIRE_FALSE(parse_decimal<uint32_t, 2>("-1.5"));
+    REQUIRE(parse_decimal<uint32_t, 2>("-0.00") == 0u);
+}
+
+TEST_CASE("Test parse_decimal with decimal grammar")
+{
+    constexpr auto REJECT = DecimalRounding::REJECT;
+    REQUIRE_FALSE(parse_decimal<int, 2, REJECT, DECIMAL_NUMBER_GRAMMAR>("+1.5"));
+    REQUIRE_FALSE(parse_decimal<int, 2, REJECT, DECIMAL_NUMBER_GRAMMAR>("1_0.5"));
+    REQUIRE(parse_decimal<int, 2, REJECT, DECIMAL_NUMBER_GRAMMAR>("-10.5") == -1050);
+}
+
+TEST_CASE("Test parse_decimal_prefix")
+{
+    auto result = parse_decimal_prefix<int, 2>("3.25 USD");
+    REQUIRE(result);
+    REQUIRE(result.value == 325);
+    REQUIRE(result.size == 4);
+
+    result = parse_decimal_prefix<int, 2>("3.256");
+    REQUIRE(result.error == std::errc::invalid_argument);
+    REQUIRE(result.size == 4);
+
+    result = parse_decimal_prefix<int, 2>("x");
+    REQUIRE(result.error == std::errc::invalid_argument);
+}
+
+TEST_CASE("Test parse_decimal rounding")
+{
+    using enum DecimalRounding;
+    REQUIRE(parse_decimal<int, 2, TRUNCATE>("1.239") == 123);
+    REQUIRE(parse_decimal<int, 2, TRUNCATE>("-1.239") == -123);
+    REQUIRE(parse_decimal<int, 2, HALF_UP>("1.235") == 124);
+    REQUIRE(parse_decimal<int, 2, HALF_UP>("1.2349") == 123);
+    REQUIRE(parse_decimal<int, 2, HALF_UP>("-1.235") == -124);
+    REQUIRE(parse_decimal<int, 2, HALF_EVEN>("1.235") == 124);
+    REQUIRE(parse_decimal<int, 2, HALF_EVEN>("1.225") == 122);
+    REQUIRE(parse_decimal<int, 2, HALF_EVEN>("1.2250001") == 123);
+    REQUIRE(parse_decimal<int, 2, HALF_EVEN>("-1.225") == -122);
+    REQUIRE(parse_decimal<int, 2, HALF_EVEN>("1.99_5") == 200);
+    REQUIRE(parse_decimal<int, 0, HALF_EVEN>("2.5") == 2);
+    REQUIRE(parse_decimal<int, 0, HALF_EVEN>("3.5") == 4);
+    REQUIRE(parse_decimal<int, 0, HALF_UP>("2.5") == 3);
+}
+
+TEST_CASE("Test parse_decimal limits")
+{
+    using enum DecimalRounding;
+    REQUIRE(parse_decimal<int8_t, 1>("12.7") == 127);
+    REQUIRE(parse_decimal<int8_t, 1>("-12.8") == -128);
+    REQUIRE_FALSE(parse_decimal<int8_t, 1>("12.8"));
+    REQUIRE_FALSE(parse_decimal<int8_t, 1>("-12.9"));
+    REQUIRE_FALSE(parse_decimal<int8_t, 1>("13"));
+    REQUIRE_FALSE(parse_decimal<int8_t, 1, HALF_UP>("12.75"));
+    REQUIRE(parse_decimal<int8_t, 1, HALF_UP>("-12.75") == -128);
+    REQUIRE_FALSE(parse_decimal<int8_t, 1, HALF_UP>("-12.85"));
+    REQUIRE(parse_decimal<int64_t, 4>("922337203685477.5807") == INT64_MAX);
+    REQUIRE(parse_decimal<int64_t, 4>("-922337203685477.5808") == INT64_MIN);
+    REQUIRE_FALSE(parse_decimal<int64_t, 4>("922337203685477.5808"));
+    REQUIRE(parse_decimal<uint64_t, 19>("1.8446744073709551615") == UINT64_MAX);
+}
+
+TEST_CASE("Test parse_decimal random values")
+{
+    std::mt19937_64 engine(7);
+    std::uniform_int_distribution<int64_t> dist(-999'999'999'999, 999'999'999'999);
+    for (int i = 0; i < 10000; ++i)
+    {
+        auto n = dist(engine);
+        auto magnitude = std::to_string(n < 0 ? -n : n);
+        if (magnitude.size() < 7)
+            magnitude.insert(0, 7 - magnitude.size(), '0');
+        auto str = std::string(n < 0 ? "-" : "") + magnitude;
+        str.insert(str.size() - 6, ".");
+        CAPTURE(str);
+        REQUIRE(parse_decimal<int64_t, 6>(str) == n);
+        REQUIRE(parse_decimal<int64_t, 8>(str) == n * 100);
+        REQUIRE(parse_decimal<int64_t, 3, DecimalRounding::TRUNCATE>(str) == n / 1000);
+    }
+}
@@ -9,6 +9,13 @@
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers_floating_point.hpp>
 
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+
 using Catch::Matchers::WithinAbs;
 
 TEST_CASE("parse_floating_point")
@@ -135,3 +142,252 @@ TEST_CASE("parse_floating_point")
     REQUIRE(std::isinf(*v));
     REQUIRE(*v < 0);
 }
+
+namespace
+{
+    template <typename T>
+    T parse_reference(const std::string& str)
+    {
+        std::string digits;
+        for (char c : str)
+        {
+            if (c != '_')
+                digits.push_back(c);
+        }
+        if constexpr (std::is_same_v<T, float>)
+            return std::strtof(digits.c_str(), nullptr);
+        else
+            return std::strtod(digits.c_str(), nullptr);
+    }
+
+    template <typename T>
+    void check_correctly_rounded(const std::string& str)
+    {
+        CAPTURE(str);
+        auto expected = parse_reference<T>(str);
+        if (std::isinf(expected))
+        {
+            // Numbers that round to infinity are out of range.
+            auto result = ParserTools::parse_floating_point_prefix<T>(str);
+            REQUIRE(result.error == std::errc::result_out_of_range);
+            return;
+        }
+        auto value = ParserTools::parse_floating_point<T>(str);
+        REQUIRE(value);
+        REQUIRE(std::memcmp(&*value, &expected, sizeof(T)) == 0);
+    }
+
+    std::string make_random_number(std::mt19937_64& random)
+    {
+        std::uniform_int_distribution<int> length_dist(1, 40);
+        std::uniform_int_distribution<int> digit_dist(0, 9);
+        std::string result;
+        auto int_digits = length_dist(random) % 25;
+        result.push_back(char('0' + digit_dist(random)));
+        for (int i = 0; i < int_digits; ++i)
+            result.push_back(char('0' + digit_dist(random)));
+        if (random() % 2)
+        {
+            result.push_back('.');
+            auto fraction_digits = length_dist(random);
+            for (int i = 0; i < fraction_digits; ++i)
+                result.push_back(char('0' + digit_dist(random)));
+        }
+        if (random() % 2)
+        {
+            std::uniform_int_distribution<int> exponent_dist(-330, 300);
+            result += "e" + std::to_string(exponent_dist(random));
+        }
+        return result;
+    }
+}
+
+TEST_CASE("parse_floating_point: results are correctly rounded")
+{
+    const char* hard_cases[] = {
+        "9007199254740993",
+        "9007199254740992.999999999999999999999999",
+        "9007199254740993.000000000000000000000001",
+        "1.00000000000000011102230246251565404236316680908203125",
+        "1.00000000000000011102230246251565404236316680908203124",
+        "1.00000000000000011102230246251565404236316680908203126",
+        "2.2250738585072011e-308",
+        "2.2250738585072012e-308",
+        "4.9406564584124654e-324",
+        "2.4703282292062327e-324",
+        "2.4703282292062328e-324",
+        "1.7976931348623158e308",
+        "1.7976931348623159e308",
+        "0.1",
+        "0.3",
+        "123456789012345678901234567890",
+        "7.3177701707893310e15",
+        "1_000_000.000_001e1_0",
+        "0.000000000000000000000000000000000000000000001e-290",
+        "179769313486231580793728971405303415079934132710037826936173778980444968292764750946649017977587207096330286416692887910946555547851940402630657488671505820681908902000708383676273854845817711531764475730270069855571366959622842914819860834936475292719074168444365510704342711559699508093042880177904174497791.9999999999999999999999999999999999999999999999999999999999999999999999",
+    };
+    for (auto str : hard_cases)
+        check_correctly_rounded<double>(str);
+
+    const char* hard_float_cases[] = {
+        "16777217",
+        "16777217.000000000000000000001",
+        "1.17549435e-38",
+        "1.4e-45",
+        "7.0e-46",
+        "3.4028235e38",
+        "3.4028236e38",
+        "0.1",
+    };
+    for (auto str : hard_float_cases)
+        check_correctly_rounded<float>(str);
+
+    std::mt19937_64 random(42);
+    for (int i = 0; i < 20000; ++i)
+    {
+        auto str = make_random_number(random);
+        check_correctly_rounded<double>(str);
+        if (str.find('e') == std::string::npos)
+            check_correctly_rounded<float>(str);
+    }
+}
+
+TEST_CASE("parse_floating_point: underscores")
+{
+    REQUIRE(ParserTools::parse_floating_point<double>("1_0.2_5e1_0") == 10.25e10);
+    REQUIRE(!ParserTools::parse_floating_point<double>("1__0"));
+    REQUIRE(!ParserTools::parse_floating_point<double>("10_"));
+    REQUIRE(!ParserTools::parse_floating_point<double>("10_.5"));
+    REQUIRE(!ParserTools::parse_floating_point<double>("10._5"));
+    REQUIRE(!ParserTools::parse_floating_point<double>("10.5_"));
+    REQUIRE(!ParserTools::parse_floating_point<double>("10.5__5"));
+    REQUIRE(!ParserTools::parse_floating_point<double>("10.5e_5"));
+    REQUIRE(!ParserTools::parse_floating_point<double>("10.5e5_"));
+    REQUIRE(!ParserTools::parse_floating_point<double>("10.5e5__0"));
+}
+
+TEST_CASE("parse_floating_point: halfway between two doubles")
+{
+    if constexpr (std::numeric_limits<long double>::digits >= 64)
+    {
+        std::mt19937_64 random(7);
+        std::uniform_int_distribution<int> exponent_dist(-1000, 1000);
+        for (int i = 0; i < 300; ++i)
+        {
+            auto a = std::ldexp(1.0 + double(random() % 1000000) / 1e6,
+                                exponent_dist(random));
+            auto b = std::nextafter(a, INFINITY);
+            auto halfway = (static_cast<long double>(a) + b) / 2;
+            char buffer[1200];
+            std::snprintf(buffer, sizeof(buffer), "%.1000Le", halfway);
+            std::string str = buffer;
+            check_correctly_rounded<double>(str);
+
+            // Just above and below halfway.
+            auto e = str.find('e');
+            auto above = str.substr(0, e) + "1" + str.substr(e);
+            check_correctly_rounded<double>(above);
+            auto last = str.find_last_not_of('0', e - 1);
+            auto below = str;
+            below[last]--;
+            check_correctly_rounded<double>(below);
+        }
+    }
+}
+
+TEST_CASE("parse_floating_point_prefix")
+{
+    using ParserTools::parse_floating_point_prefix;
+
+    auto result = parse_floating_point_prefix<double>("1.25,3");
+    REQUIRE(result);
+    REQUIRE(result.value == 1.25);
+    REQUIRE(result.size == 4);
+
+    result = parse_floating_point_prefix<double>("1.e");
+    REQUIRE(result.value == 1);
+    REQUIRE(result.size == 2);
+
+    result = parse_floating_point_prefix<double>("2e-3x");
+    REQUIRE(result.value == 2e-3);
+    REQUIRE(result.size == 4);
+
+    result = parse_floating_point_prefix<double>("1_0.5_");
+    REQUIRE(result.value == 10.5);
+    REQUIRE(result.size == 5);
+
+    result = parse_floating_point_prefix<double>("1._5");
+    REQUIRE(result.value == 1);
+    REQUIRE(result.size == 2);
+
+    result = parse_floating_point_prefix<double>("-Infinity ");
+    REQUIRE(result.value == -INFINITY);
+    REQUIRE(result.size == 9);
+
+    result = parse_floating_point_prefix<double>("x");
+    REQUIRE(result.error == std::errc::invalid_argument);
+    REQUIRE(result.size == 0);
+
+    result = parse_floating_point_prefix<double>("+.5");
+    REQUIRE(result.error == std::errc::invalid_argument);
+    REQUIRE(result.size == 1);
+
+    result = parse_floating_point_prefix<double>("1e400");
+    REQUIRE(result.error == std::errc::result_out_of_range);
+    REQUIRE(result.size == 2);
+}
+
+TEST_CASE("parse_floating_point_prefix decides overflow on the value")
+{
+    using ParserTools::parse_floating_point_prefix;
+    for (auto str : {"9e308", "1.8e308", "-1.8e308", "1797693134862315800000e288",
+                     "123456789012345678901234567890e300", "1e99999999999"})
+    {
+        CAPTURE(str);
+        auto result = parse_floating_point_prefix<double>(str);
+        REQUIRE(result.error == std::errc::result_out_of_range);
+    }
+
+    auto result = parse_floating_point_prefix<double>("-9e308");
+    REQUIRE(result.size == 3);
+    std::string digits = "1" + std::string(400, '0');
+    result = parse_floating_point_prefix<double>(digits);
+    REQUIRE(result.error == std::errc::result_out_of_range);
+    REQUIRE(result.size == 0);
+    REQUIRE(parse_floating_point_prefix<float>("3.5e38").error
+            == std::errc::result_out_of_range);
+
+    result = parse_floating_point_prefix<double>("0e999");
+    REQUIRE(result.error == std::errc());
+    REQUIRE(result.value == 0);
+    REQUIRE(result.size == 5);
+    result = parse_floating_point_prefix<double>("0.0000000001e309");
+    REQUIRE(result.error == std::errc());
+    REQUIRE(result.value == 1e299);
+    result = parse_floating_point_prefix<double>("0.001e310");
+    REQUIRE(result.error == std::errc());
+    REQUIRE(result.value == 1e307);
+    result = parse_floating_point_prefix<double>("1.7976931348623158e308");
+    REQUIRE(result.error == std::errc());
+    REQUIRE(result.value == 1.7976931348623157e308);
+    REQUIRE(parse_floating_point_prefix<double>("1e-99999999999").value == 0);
+    REQUIRE(parse_floating_point_prefix<float>("0.01e40").value == 1e38f);
+}
+
+TEST_CASE("parse_floating_point with a compile-time grammar")
+{
+    using ParserTools::parse_floating_point;
+    constexpr auto D = ParserTools::DECIMAL_NUMBER_GRAMMAR;
+    REQUIRE(parse_floating_point<double, D>("-1.5e3") == -1500.0);
+    REQUIRE(parse_floating_point<float, D>("0.25") == 0.25f);
+    REQUIRE(!parse_floating_point<double, D>("+1.5"));
+    REQUIRE(!parse_floating_point<double, D>("1_0.5"));
+    REQUIRE(!parse_floating_point<double, D>("1.0e1_0"));
+    REQUIRE(!parse_floating_point<double, D>("Infinity"));
+    REQUIRE(!parse_floating_point<double, D>("NaN"));
+    REQUIRE(!parse_floating_point<double, D>("null"));
+
+    constexpr ParserTools::NumberGrammar NO_NULL = {.null_keyword = false};
+    REQUIRE(!parse_floating_point<double, NO_NULL>("null"));
+    REQUIRE(parse_floating_point<double, NO_NULL>("-Infinity") == -INFINITY);
+}
@@ -0,0 +1,234 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "ParserTools/ParseInteger.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+#include <charconv>
+#include <random>
+#include <string>
+
+using namespace ParserTools;
+
+namespace
+{
+    template <typename IntT>
+    std::optional<IntT> parse_reference(std::string_view str)
+    {
+        std::string digits;
+        for (size_t i = 0; i < str.size(); ++i)
+        {
+            if (str[i] != '_')
+            {
+                digits.push_back(str[i]);
+                continue;
+            }
+            if (i == 0 || i == str.size() - 1 || str[i - 1] == '_'
+                || str[i - 1] == '-' || str[i - 1] == '+')
+            {
+                return {};
+            }
+        }
+        if (!digits.empty() && digits[0] == '+')
+            digits.erase(0, 1);
+        // from_chars doesn't accept "-0" for unsigned types.
+        if constexpr (std::is_unsigned_v<IntT>)
+        {
+            if (digits.find_first_not_of("-0") == std::string::npos
+                && digits.size() >= 2 && digits[0] == '-')
+            {
+                return IntT(0);
+            }
+        }
+        IntT value = 0;
+        auto [ptr, ec] = std::from_chars(digits.data(),
+                                         digits.data() + digits.size(), value);
+        if (ec != std::errc() || ptr != digits.data() + digits.size()
+            || digits.empty())
+        {
+            return {};
+        }
+        return value;
+    }
+
+    template <typename IntT>
+    void check_parse_integer(const std::string& str)
+    {
+        CAPTURE(str);
+        REQUIRE(parse_integer<IntT>(str, false) == parse_reference<IntT>(str));
+    }
+
+    template <typename IntT>
+    void check_random_strings(std::mt19937& random, size_t count)
+    {
+        const std::string chars = "0123456789";
+        std::uniform_int_distribution<size_t> length_dist(1, 24);
+        std::uniform_int_distribution<size_t> char_dist(0, 99);
+        for (size_t n = 0; n < count; ++n)
+        {
+            std::string str;
+            auto length = length_dist(random);
+            if (n % 3 == 1)
+                str.push_back('-');
+            for (size_t i = 0; i < length; ++i)
+            {
+                auto c = char_dist(random);
+                if (c < 90)
+                    str.push_back(char('0' + c % 10));
+                else if (c < 97 && i != 0)
+                    str.push_back('_');
+                else
+                    str.push_back("x +"[c % 3]);
+            }
+            check_parse_integer<IntT>(str);
+        }
+    }
+}
+
+TEST_CASE("parse_integer: decimal boundaries")
+{
+    check_parse_integer<int64_t>("9223372036854775807");
+    check_parse_integer<int64_t>("9223372036854775808");
+    check_parse_integer<int64_t>("-9223372036854775808");
+    check_parse_integer<int64_t>("-9223372036854775809");
+    check_parse_integer<uint64_t>("18446744073709551615");
+    check_parse_integer<uint64_t>("18446744073709551616");
+    check_parse_integer<uint64_t>("99999999999999999999");
+    check_parse_integer<uint64_t>("000000000000000000000000000000001");
+    check_parse_integer<int32_t>("2147483647");
+    check_parse_integer<int32_t>("2147483648");
+    check_parse_integer<int32_t>("-2147483648");
+    check_parse_integer<int32_t>("-2147483649");
+    check_parse_integer<uint32_t>("4294967295");
+    check_parse_integer<uint32_t>("4294967296");
+    check_parse_integer<int16_t>("-32768");
+    check_parse_integer<int8_t>("127");
+    check_parse_integer<int8_t>("-129");
+    check_parse_integer<int8_t>("-1280");
+    check_parse_integer<int64_t>("-92233720368547758080");
+    REQUIRE(parse_integer<int8_t>("-0x80", true) == -128);
+    REQUIRE(!parse_integer<int8_t>("-0x800", true));
+    REQUIRE(!parse_integer<int8_t>("-0x81", true));
+    REQUIRE(parse_integer<int64_t>("1234567890123456", false) == 1234567890123456);
+    REQUIRE(parse_integer<int64_t>("-12345678", false) == -12345678);
+}
+
+TEST_CASE("parse_integer: integers wider than 64 bits")
+{
+    __extension__ typedef __int128 Int128;
+    constexpr auto TEN_TO_THE_18 = Int128(1000000000000000000);
+    auto expected = (Int128(123456789) * TEN_TO_THE_18
+                     + Int128(12345678901234567));
+    REQUIRE(parse_integer<Int128>("123456789012345678901234567", false) == expected);
+    REQUIRE(parse_integer<Int128>("-123456789012345678901234567", false) == -expected);
+    REQUIRE(parse_integer<Int128>("1234567890_1234567890_1234567", false) == expected);
+}
+
+TEST_CASE("parse_integer: underscores and invalid characters after the fast path")
+{
+    REQUIRE(parse_integer<int64_t>("12345678_9", false) == 123456789);
+    REQUIRE(parse_integer<int64_t>("1234_5678_9012_3456", false) == 1234567890123456);
+    REQUIRE(!parse_integer<int64_t>("123456789_", false));
+    REQUIRE(!parse_integer<int64_t>("12345678__9", false));
+    REQUIRE(!parse_integer<int64_t>("123456789x", false));
+    REQUIRE(!parse_integer<int64_t>("1234567812345678 ", false));
+    REQUIRE(!parse_integer<int64_t>("12345678/", false));
+    REQUIRE(!parse_integer<int64_t>("1234567:", false));
+}
+
+TEST_CASE("parse_integer: random decimal strings")
+{
+    std::mt19937 random(1234);
+    check_random_strings<int8_t>(random, 2000);
+    check_random_strings<uint16_t>(random, 2000);
+    check_random_strings<int32_t>(random, 5000);
+    check_random_strings<uint32_t>(random, 5000);
+    check_random_strings<int64_t>(random, 10000);
+    check_random_strings<uint64_t>(random, 10000);
+}
+
+TEST_CASE("parse_integer_prefix")
+{
+    auto result = parse_integer_prefix<int32_t>("123,456");
+    REQUIRE(result);
+    REQUIRE(result.value == 123);
+    REQUIRE(result.size == 3);
+
+    result = parse_integer_prefix<int32_t>("-1_000_000 rest");
+    REQUIRE(result.value == -1000000);
+    REQUIRE(result.size == 10);
+
+    result = parse_integer_prefix<int32_t>("12_");
+    REQUIRE(result.value == 12);
+    REQUIRE(result.size == 2);
+
+    result = parse_integer_prefix<int32_t>("12__3");
+    REQUIRE(result.value == 12);
+    REQUIRE(result.size == 2);
+
+    result = parse_integer_prefix<int32_t>("0x1Fg", true);
+    REQUIRE(result.value == 31);
+    REQUIRE(result.size == 4);
+
+    result = parse_integer_prefix<int32_t>("0xg", true);
+    REQUIRE(result.value == 0);
+    REQUIRE(result.size == 1);
+
+    result = parse_integer_prefix<int32_t>("true;");
+    REQUIRE(result.value == 1);
+    REQUIRE(result.size == 4);
+}
+
+TEST_CASE("parse_integer_prefix errors")
+{
+    auto result = parse_integer_prefix<int32_t>("");
+    REQUIRE(result.error == std::errc::invalid_argument);
+    REQUIRE(result.size == 0);
+
+    result = parse_integer_prefix<int32_t>("-x");
+    REQUIRE(result.error == std::errc::invalid_argument);
+    REQUIRE(result.size == 1);
+
+    result = parse_integer_prefix<int32_t>("21474836470");
+    REQUIRE(result.error == std::errc::result_out_of_range);
+    REQUIRE(result.size == 10);
+
+    auto int8_result = parse_integer_prefix<int8_t>("-129");
+    REQUIRE(int8_result.error == std::errc::result_out_of_range);
+    REQUIRE(int8_result.size == 3);
+
+    auto uint32_result = parse_integer_prefix<uint32_t>("-5");
+    REQUIRE(uint32_result.error == std::errc::result_out_of_range);
+    REQUIRE(uint32_result.size == 1);
+}
+
+TEST_CASE("parse_integer with a compile-time grammar")
+{
+    constexpr auto D = DECIMAL_NUMBER_GRAMMAR;
+    REQUIRE(parse_integer<int32_t, D>("-123") == -123);
+    REQUIRE(parse_integer<int64_t, D>("1234567890123") == 1234567890123);
+    REQUIRE(!parse_integer<int32_t, D>("+123"));
+    REQUIRE(!parse_integer<int32_t, D>("1_000"));
+    REQUIRE(!parse_integer<int32_t, D>("true"));
+    REQUIRE(!parse_integer<int32_t, D>("null"));
+    REQUIRE(!parse_integer<int32_t, D>("0x10"));
+
+    auto result = parse_integer_prefix<int32_t, D>("0x10");
+    REQUIRE(result.value == 0);
+    REQUIRE(result.size == 1);
+
+    constexpr NumberGrammar HEX_ONLY = {
+        .binary_prefix = false,
+        .octal_prefix = false,
+        .boolean_keywords = false
+    };
+    REQUIRE(parse_integer<int32_t, HEX_ONLY>("0x1_0") == 16);
+    REQUIRE(!parse_integer<int32_t, HEX_ONLY>("0b10"));
+    REQUIRE(!parse_integer<int32_t, HEX_ONLY>("true"));
+    REQUIRE(parse_integer<int32_t, HEX_ONLY>("null") == 0);
+    REQUIRE(parse_integer<int32_t, DEFAULT_NUMBER_GRAMMAR>("0o17") == 15);
+}
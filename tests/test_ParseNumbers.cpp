@@ -0,0 +1,136 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "ParserTools/ParseNumbers.hpp"
+#include "ParserTools/DelimiterFinders.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+#include <string>
+#include <vector>
+
+using namespace ParserTools;
+
+namespace
+{
+    std::vector<bool> get_bits(std::span<const uint64_t> bitmap, size_t count)
+    {
+        std::vector<bool> result;
+        for (size_t i = 0; i < count; ++i)
+            result.push_back(is_valid(bitmap, i));
+        return result;
+    }
+}
+
+TEST_CASE("Test parse_integers")
+{
+    int values[6];
+    uint64_t bits[1];
+    auto result = parse_integers("12,-3,,4x,+5,0x10", FindChar(','),
+                                 std::span<int>(values), bits);
+    REQUIRE(result.size == 6);
+    REQUIRE_FALSE(result.overflow);
+    REQUIRE(std::vector<int>(values, values + 6)
+            == std::vector<int>{12, -3, 0, 0, 5, 16});
+    REQUIRE(get_bits(bits, 6)
+            == std::vector<bool>{true, true, false, false, true, true});
+}
+
+TEST_CASE("Test parse_integers with trailing delimiter")
+{
+    int values[4];
+    uint64_t bits[1];
+    auto result = parse_integers("1 2 ", FindChar(' '),
+                                 std::span<int>(values), bits);
+    REQUIRE(result.size == 3);
+    REQUIRE(get_bits(bits, 3) == std::vector<bool>{true, true, false});
+}
+
+TEST_CASE("Test parse_integers out of range")
+{
+    int8_t values[3];
+    uint64_t bits[1];
+    auto result = parse_integers("127;128;-128", FindChar(';'),
+                                 std::span<int8_t>(values), bits);
+    REQUIRE(result.size == 3);
+    REQUIRE(get_bits(bits, 3) == std::vector<bool>{true, false, true});
+    REQUIRE(values[0] == 127);
+    REQUIRE(values[2] == -128);
+}
+
+TEST_CASE("Test parse_integers overflow")
+{
+    int values[2];
+    uint64_t bits[1];
+    auto result = parse_integers("1,2,3", FindChar(','),
+                                 std::span<int>(values), bits);
+    REQUIRE(result.size == 2);
+    REQUIRE(result.overflow);
+    REQUIRE(values[1] == 2);
+}
+
+TEST_CASE("Test parse_integers with decimal grammar")
+{
+    int values[2];
+    uint64_t bits[1];
+    auto result = parse_integers<int, DECIMAL_NUMBER_GRAMMAR>(
+        "0x10,10", FindChar(','), std::span<int>(values), bits);
+    REQUIRE(result.size == 2);
+    REQUIRE(get_bits(bits, 2) == std::vector<bool>{false, true});
+}
+
+TEST_CASE("Test parse_integers many values")
+{
+    std::string str;
+    for (int i = 0; i < 200; ++i)
+        str += std::to_string(i * 37 - 1000) + (i % 7 == 3 ? "?\n" : "\n");
+    str.pop_back();
+    std::vector<int> values(200);
+    std::vector<uint64_t> bits(get_validity_bitmap_size(values.size()));
+    auto result = parse_integers(str, FindChar('\n'),
+                                 std::span<int>(values), bits);
+    REQUIRE(result.size == 200);
+    for (int i = 0; i < 200; ++i)
+    {
+        CAPTURE(i);
+        REQUIRE(is_valid(bits, size_t(i)) == (i % 7 != 3));
+        if (i % 7 != 3)
+            REQUIRE(values[size_t(i)] == i * 37 - 1000);
+    }
+}
+
+TEST_CASE("Test parse_integers with too small bitmap")
+{
+    std::vector<int> values(65);
+    uint64_t bits[1];
+    REQUIRE_THROWS(parse_integers("1", FindChar(','),
+                                  std::span<int>(values), bits));
+}
+
+TEST_CASE("Test parse_floats")
+{
+    double values[5];
+    uint64_t bits[1];
+    auto result = parse_floats("1.5\t-2e3\tnan?\t\t0.25", FindChar('\t'),
+                               std::span<double>(values), bits);
+    REQUIRE(result.size == 5);
+    REQUIRE(get_bits(bits, 5)
+            == std::vector<bool>{true, true, false, false, true});
+    REQUIRE(values[0] == 1.5);
+    REQUIRE(values[1] == -2000);
+    REQUIRE(values[4] == 0.25);
+}
+
+TEST_CASE("Test parse_floats with whitespace delimiters")
+{
+    float values[4];
+    uint64_t bits[1];
+    auto result = parse_floats("1.25  2.5 \n 3", FindSequenceOf(" \n"),
+                               std::span<float>(values), bits);
+    REQUIRE(result.size == 3);
+    REQUIRE(get_bits(bits, 3) == std::vector<bool>{true, true, true});
+    REQUIRE(values[2] == 3);
+}
@@ -0,0 +1,135 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "ParserTools/ParseTimestamp.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <random>
+#include <string>
+
+using namespace ParserTools;
+
+TEST_CASE("Test parse_timestamp")
+{
+    auto ts = parse_timestamp("2024-03-07T12:34:56.123456Z");
+    REQUIRE(ts);
+    REQUIRE(ts->year == 2024);
+    REQUIRE(ts->month == 3);
+    REQUIRE(ts->day == 7);
+    REQUIRE(ts->hour == 12);
+    REQUIRE(ts->minute == 34);
+    REQUIRE(ts->second == 56);
+    REQUIRE(ts->nanosecond == 123456000);
+    REQUIRE(ts->utc_offset == 0);
+    REQUIRE(ts->has_utc_offset);
+}
+
+TEST_CASE("Test parse_timestamp variants")
+{
+    auto ts = parse_timestamp("2024-02-29");
+    REQUIRE(ts);
+    REQUIRE(ts->hour == 0);
+    REQUIRE_FALSE(ts->has_utc_offset);
+
+    ts = parse_timestamp("1999-12-31 23:59:59,5+01:30");
+    REQUIRE(ts);
+    REQUIRE(ts->nanosecond == 500000000);
+    REQUIRE(ts->utc_offset == 90);
+
+    ts = parse_timestamp("1999-12-31t23:59:59.1234567891234-0130");
+    REQUIRE(ts);
+    REQUIRE(ts->nanosecond == 123456789);
+    REQUIRE(ts->utc_offset == -90);
+
+    ts = parse_timestamp("2000-01-01T00:00:00+05");
+    REQUIRE(ts);
+    REQUIRE(ts->utc_offset == 300);
+    REQUIRE(ts->has_utc_offset);
+}
+
+TEST_CASE("Test parse_timestamp invalid")
+{
+    REQUIRE_FALSE(parse_timestamp(""));
+    REQUIRE_FALSE(parse_timestamp("2024-03"));
+    REQUIRE_FALSE(parse_timestamp("2023-02-29"));
+    REQUIRE_FALSE(parse_timestamp("2024-13-01"));
+    REQUIRE_FALSE(parse_timestamp("2024-00-01"));
+    REQUIRE_FALSE(parse_timestamp("2024-04-31"));
+    REQUIRE_FALSE(parse_timestamp("2024/03/07"));
+    REQUIRE_FALSE(parse_timestamp("2024-03-07T"));
+    REQUIRE_FALSE(parse_timestamp("2024-03-07T12:34"));
+    REQUIRE_FALSE(parse_timestamp("2024-03-07T24:00:00"));
+    REQUIRE_FALSE(parse_timestamp("2024-03-07T12:60:00"));
+    REQUIRE_FALSE(parse_timestamp("2024-03-07T12:34:60"));
+    REQUIRE_FALSE(parse_timestamp("2024-03-07T12:34:56."));
+    REQUIRE_FALSE(parse_timestamp("2024-03-07T12:34:56+24:00"));
+    REQUIRE_FALSE(parse_timestamp("2024-03-07T12:34:56+1"));
+}
+
+TEST_CASE("Test parse_timestamp_prefix")
+{
+    auto result = parse_timestamp_prefix("2024-03-07T12:34:56Z,42");
+    REQUIRE(result);
+    REQUIRE(result.size == 20);
+
+    result = parse_timestamp_prefix("2024-03-07 foo");
+    REQUIRE(result);
+    REQUIRE(result.size == 10);
+
+    result = parse_timestamp_prefix("2024-03-07T12:34:56+1");
+    REQUIRE(result);
+    REQUIRE(result.size == 19);
+
+    result = parse_timestamp_prefix("2024-03-07T12:3x:56");
+    REQUIRE(result.error == std::errc::invalid_argument);
+    REQUIRE(result.size == 15);
+
+    result = parse_timestamp_prefix("20x4-03-07");
+    REQUIRE(result.error == std::errc::invalid_argument);
+    REQUIRE(result.size == 2);
+
+    result = parse_timestamp_prefix("2024-03-32");
+    REQUIRE(result.error == std::errc::invalid_argument);
+    REQUIRE(result.size == 8);
+}
+
+TEST_CASE("Test parse_epoch_nanoseconds")
+{
+    REQUIRE(parse_epoch_nanoseconds("1970-01-01T00:00:00Z") == 0);
+    REQUIRE(parse_epoch_nanoseconds("1970-01-01T00:00:00.000000001Z") == 1);
+    REQUIRE(parse_epoch_nanoseconds("1969-12-31T23:59:59.999999999Z") == -1);
+    REQUIRE(parse_epoch_nanoseconds("2024-03-07T12:34:56.123456Z")
+            == 1709814896123456000);
+    REQUIRE(parse_epoch_nanoseconds("2024-03-07T13:34:56.123456+01:00")
+            == 1709814896123456000);
+    REQUIRE(parse_epoch_nanoseconds("2262-04-11T23:47:16.854775807Z") == INT64_MAX);
+    REQUIRE_FALSE(parse_epoch_nanoseconds("2262-04-11T23:47:16.854775808Z"));
+    REQUIRE(parse_epoch_nanoseconds("1677-09-21T00:12:43.145224192Z") == INT64_MIN);
+    REQUIRE_FALSE(parse_epoch_nanoseconds("1677-09-21T00:12:43.145224191Z"));
+    auto result = parse_epoch_nanoseconds_prefix("9999-12-31");
+    REQUIRE(result.error == std::errc::result_out_of_range);
+}
+
+TEST_CASE("Test parse_epoch_nanoseconds random dates")
+{
+    using namespace std::chrono;
+    std::mt19937 engine(11);
+    std::uniform_int_distribution<int> dist(-100000, 100000);
+    for (int i = 0; i < 10000; ++i)
+    {
+        const sys_days date{days(dist(engine))};
+        const year_month_day ymd(date);
+        char buffer[32];
+        snprintf(buffer, sizeof(buffer), "%04d-%02u-%02uT01:02:03Z",
+                 int(ymd.year()), unsigned(ymd.month()), unsigned(ymd.day()));
+        CAPTURE(buffer);
+        const auto expected = duration_cast<nanoseconds>(
+            date.time_since_epoch() + hours(1) + minutes(2) + seconds(3)).count();
+        REQUIRE(parse_epoch_nanoseconds(buffer) == expected);
+    }
+}
@@ -0,0 +1,115 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "ParserTools/PrefetchingStreamBuffer.hpp"
+#include "ParserTools/DelimiterFinders.hpp"
+#include "ParserTools/StreamTokenizer.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+#include <sstream>
+#include <vector>
+
+using namespace ParserTools;
+
+namespace
+{
+    std::vector<std::string> get_tokens(std::istream& stream, size_t block_size)
+    {
+        std::vector<std::string> result;
+        PrefetchingStreamBuffer buffer(&stream, block_size);
+        for (auto item : tokenize(std::move(buffer), FindNewline()))
+            result.emplace_back(item.string());
+        return result;
+    }
+
+    std::string make_lines(size_t count)
+    {
+        std::string result;
+        for (size_t i = 0; i < count; ++i)
+        {
+            result += std::string(i % 23, char('a' + i % 26));
+            result += i % 3 == 0 ? "\r\n" : "\n";
+        }
+        return result;
+    }
+}
+
+TEST_CASE("PrefetchingStreamBuffer: tokenize lines")
+{
+    auto str = make_lines(1000);
+    std::stringstream expected_ss(str);
+    std::vector<std::string> expected;
+    for (auto item : tokenize(expected_ss, FindNewline()))
+        expected.emplace_back(item.string());
+
+    for (size_t block_size : {1, 2, 7, 64, 4096})
+    {
+        CAPTURE(block_size);
+        std::stringstream ss(str);
+        REQUIRE(get_tokens(ss, block_size) == expected);
+    }
+}
+
+TEST_CASE("PrefetchingStreamBuffer: tokens longer than a block")
+{
+    std::string str = std::string(100, 'x') + "\n" + std::string(30, 'y')
+                      + "\n" + std::string(200, 'z');
+    std::stringstream ss(str);
+    REQUIRE(get_tokens(ss, 16) == std::vector<std::string>{
+        std::string(100, 'x'), std::string(30, 'y'), std::string(200, 'z')});
+}
+
+TEST_CASE("PrefetchingStreamBuffer: token spanning many blocks")
+{
+    std::string line;
+    for (size_t i = 0; i < 64 * 1000; ++i)
+        line += char('a' + i % 26);
+    std::stringstream ss("abc\n" + line + "\ndef");
+    std::vector<std::string> tokens;
+    auto tokenizer = tokenize(PrefetchingStreamBuffer(&ss, 64), FindNewline());
+    auto it = tokenizer.begin();
+    for (; it != tokenizer.end(); ++it)
+        tokens.emplace_back(it->string());
+    REQUIRE(tokens == std::vector<std::string>{"abc", line, "def"});
+    // Copying the whole token for every block would move about 32 MB.
+    REQUIRE(it.buffer().bytes_moved() < 4 * line.size());
+}
+
+TEST_CASE("PrefetchingStreamBuffer: empty stream")
+{
+    std::stringstream ss;
+    REQUIRE(get_tokens(ss, 16) == std::vector<std::string>{""});
+}
+
+TEST_CASE("PrefetchingStreamBuffer: stop before the end of the stream")
+{
+    std::stringstream ss(make_lines(10000));
+    PrefetchingStreamBuffer buffer(&ss, 64);
+    REQUIRE(buffer);
+    REQUIRE(buffer.fill());
+    REQUIRE(buffer.string().size() == 64);
+    // The destructor must stop the helper thread.
+}
+
+TEST_CASE("PrefetchingStreamBuffer: stream exceptions are rethrown")
+{
+    class FailingStreambuf : public std::streambuf
+    {
+    protected:
+        int_type underflow() override
+        {
+            throw std::runtime_error("read error");
+        }
+    };
+
+    FailingStreambuf buf;
+    std::istream stream(&buf);
+    stream.exceptions(std::ios::badbit);
+    PrefetchingStreamBuffer buffer(&stream, 64);
+    REQUIRE_THROWS(buffer.fill());
+    REQUIRE_FALSE(buffer.fill());
+}
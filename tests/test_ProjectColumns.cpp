@@ -0,0 +1,141 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "ParserTools/ProjectColumns.hpp"
+#include "ParserTools/SimdLevel.hpp"
+#include "ParserTools/StringTokenizer.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace ParserTools;
+
+namespace
+{
+    template <typename FindDelimiterFunc>
+    std::vector<std::string_view>
+    expected_columns(std::string_view str, FindDelimiterFunc finder,
+                     const std::vector<size_t>& columns)
+    {
+        auto parts = split(str, finder);
+        std::vector<std::string_view> result;
+        for (auto column : columns)
+        {
+            if (column >= parts.size())
+                break;
+            result.push_back(parts[column]);
+        }
+        return result;
+    }
+
+    template <typename FindDelimiterFunc>
+    std::vector<std::string_view>
+    get_columns(std::string_view str, FindDelimiterFunc finder,
+                const std::vector<size_t>& columns)
+    {
+        std::vector<std::string_view> result(columns.size());
+        result.resize(project_columns(str, finder, columns, result));
+        return result;
+    }
+}
+
+TEST_CASE("Test project_columns")
+{
+    std::vector<std::string_view> fields(3);
+    std::vector<size_t> columns = {1, 3, 4};
+    auto count = project_columns("a,b,c,d,e,f", FindChar(','), columns, fields);
+    REQUIRE(count == 3);
+    REQUIRE(fields == std::vector<std::string_view>{"b", "d", "e"});
+
+    count = project_columns("a,b,c,d", FindChar(','), columns, fields);
+    REQUIRE(count == 2);
+
+    count = project_columns("a,b,c,d,", FindChar(','), columns, fields);
+    REQUIRE(count == 3);
+    REQUIRE(fields[2].empty());
+}
+
+TEST_CASE("Test project_columns with other finders")
+{
+    std::vector<size_t> columns = {0, 2};
+    REQUIRE(get_columns("a  b \tc d", FindWhitespace(), columns)
+            == std::vector<std::string_view>{"a", "c"});
+    REQUIRE(get_columns("a::b::", FindSubstring("::"), columns)
+            == std::vector<std::string_view>{"a", ""});
+}
+
+TEST_CASE("Test find_nth_byte")
+{
+    REQUIRE(find_nth_byte("", ',', 0) == 0);
+    REQUIRE(find_nth_byte("a,b,c", ',', 0) == 1);
+    REQUIRE(find_nth_byte("a,b,c", ',', 1) == 3);
+    REQUIRE(find_nth_byte("a,b,c", ',', 2) == 5);
+
+    std::mt19937 engine(13);
+    std::uniform_int_distribution<int> dist(0, 9);
+    for (size_t size = 0; size < 400; size += 7)
+    {
+        std::string str;
+        for (size_t i = 0; i < size; ++i)
+            str.push_back(dist(engine) < 2 ? ',' : dist(engine) == 0 ? '\0' : 'x');
+        for (char ch : {',', '\0'})
+        {
+            std::vector<size_t> expected;
+            for (size_t i = 0; i < str.size(); ++i)
+            {
+                if (str[i] == ch)
+                    expected.push_back(i);
+            }
+            for (auto level : {SimdLevel::SCALAR, SimdLevel::SSE2,
+                               SimdLevel::AVX2, SimdLevel::AVX512})
+            {
+                if (level > detected_simd_level())
+                    break;
+                set_simd_level(level);
+                for (size_t n = 0; n <= expected.size(); ++n)
+                {
+                    CAPTURE(int(level), size, n, int(ch));
+                    auto pos = n < expected.size() ? expected[n] : str.size();
+                    REQUIRE(find_nth_byte(str, ch, n) == pos);
+                }
+            }
+            set_simd_level(detected_simd_level());
+        }
+    }
+}
+
+TEST_CASE("Test project_columns on random lines")
+{
+    std::mt19937 engine(17);
+    std::uniform_int_distribution<size_t> length_dist(0, 12);
+    std::uniform_int_distribution<size_t> column_dist(0, 60);
+    for (int i = 0; i < 500; ++i)
+    {
+        std::string line;
+        auto column_count = column_dist(engine);
+        for (size_t j = 0; j < column_count; ++j)
+        {
+            if (j != 0)
+                line += ',';
+            line += std::string(length_dist(engine), char('a' + j % 26));
+        }
+
+        std::vector<size_t> columns;
+        for (size_t j = 0; j < 64; ++j)
+        {
+            if (column_dist(engine) < 6)
+                columns.push_back(j);
+        }
+        CAPTURE(line, columns);
+        REQUIRE(get_columns(line, FindChar(','), columns)
+                == expected_columns(line, FindChar(','), columns));
+        REQUIRE(get_columns(line, FindSequenceOf(","), columns)
+                == expected_columns(line, FindSequenceOf(","), columns));
+    }
+}
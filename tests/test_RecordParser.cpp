@@ -0,0 +1,86 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "ParserTools/RecordParser.hpp"
+#include "ParserTools/DelimiterFinders.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+using namespace ParserTools;
+
+namespace
+{
+    struct Trade
+    {
+        int64_t id = 0;
+        std::string_view symbol;
+        double price = 0;
+        std::string venue;
+        char side = '?';
+    };
+
+    std::optional<char> parse_side(std::string_view str)
+    {
+        if (str == "B" || str == "S")
+            return str[0];
+        return {};
+    }
+
+    using TradeParser = RecordParser<Trade,
+        RecordField<0, &Trade::id>,
+        RecordField<2, &Trade::symbol>,
+        RecordField<3, &Trade::price>,
+        RecordField<4, &Trade::side, parse_side>,
+        RecordField<6, &Trade::venue>>;
+}
+
+TEST_CASE("Test RecordParser")
+{
+    static_assert(TradeParser::COLUMN_COUNT == 7);
+    auto trade = TradeParser::parse("42,ignored,ABC,12.5,S,x,XOSL,more",
+                                    FindChar(','));
+    REQUIRE(trade);
+    REQUIRE(trade->id == 42);
+    REQUIRE(trade->symbol == "ABC");
+    REQUIRE(trade->price == 12.5);
+    REQUIRE(trade->side == 'S');
+    REQUIRE(trade->venue == "XOSL");
+}
+
+TEST_CASE("Test RecordParser with invalid columns")
+{
+    REQUIRE_FALSE(TradeParser::parse("x,,ABC,12.5,S,,XOSL", FindChar(',')));
+    REQUIRE_FALSE(TradeParser::parse("1,,ABC,12.5x,S,,XOSL", FindChar(',')));
+    REQUIRE_FALSE(TradeParser::parse("1,,ABC,12.5,Q,,XOSL", FindChar(',')));
+    // The unused columns aren't converted.
+    REQUIRE(TradeParser::parse("1,?,ABC,12.5,B,?,XOSL", FindChar(',')));
+}
+
+TEST_CASE("Test RecordParser with too few columns")
+{
+    REQUIRE_FALSE(TradeParser::parse("1,,ABC,12.5,B,", FindChar(',')));
+    REQUIRE_FALSE(TradeParser::parse("", FindChar(',')));
+    auto trade = TradeParser::parse("1,,ABC,12.5,B,,", FindChar(','));
+    REQUIRE(trade);
+    REQUIRE(trade->venue.empty());
+}
+
+TEST_CASE("Test RecordParser with the same column twice")
+{
+    struct Pair
+    {
+        int a = 0;
+        long b = 0;
+    };
+    using PairParser = RecordParser<Pair,
+        RecordField<1, &Pair::a>,
+        RecordField<1, &Pair::b, [](std::string_view s) {return parse_integer<long>(s, true);}>>;
+    Pair pair;
+    REQUIRE(PairParser::parse("skip 17", FindChar(' '), pair));
+    REQUIRE(pair.a == 17);
+    REQUIRE(pair.b == 17);
+    REQUIRE_FALSE(PairParser::parse("skip 0x11", FindChar(' '), pair));
+}
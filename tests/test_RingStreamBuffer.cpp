@@ -0,0 +1,89 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "ParserTools/RingStreamBuffer.hpp"
+#include "ParserTools/DelimiterFinders.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+#include <sstream>
+#include <vector>
+
+using namespace ParserTools;
+
+namespace
+{
+    std::string make_lines(size_t count)
+    {
+        std::string result;
+        for (size_t i = 0; i < count; ++i)
+        {
+            result += std::string(i % 37, char('a' + i % 26));
+            result += '\n';
+        }
+        return result;
+    }
+
+    template <typename Buffer>
+    std::vector<std::string> get_tokens(Buffer buffer, size_t& bytes_moved)
+    {
+        std::vector<std::string> result;
+        auto tokenizer = tokenize(std::move(buffer), FindNewline());
+        auto it = tokenizer.begin();
+        for (; it != tokenizer.end(); ++it)
+            result.emplace_back(it->string());
+        bytes_moved = it.buffer().bytes_moved();
+        return result;
+    }
+}
+
+TEST_CASE("RingStreamBuffer: tokenize without moving data")
+{
+    auto str = make_lines(5000);
+
+    std::stringstream expected_ss(str);
+    size_t stream_buffer_moved = 0;
+    auto expected = get_tokens(StreamBuffer(&expected_ss), stream_buffer_moved);
+    REQUIRE(stream_buffer_moved != 0);
+
+    std::stringstream ss(str);
+    size_t ring_buffer_moved = 0;
+    RingStreamBuffer buffer(&ss, StreamReadMode::THROUGHPUT, 1);
+    REQUIRE(buffer.capacity() != 0);
+    REQUIRE(buffer.capacity() < str.size());
+    REQUIRE(get_tokens(std::move(buffer), ring_buffer_moved) == expected);
+    REQUIRE(ring_buffer_moved == 0);
+}
+
+TEST_CASE("RingStreamBuffer: data wrapping around the end of the ring")
+{
+    std::stringstream ss(make_lines(2000));
+    RingStreamBuffer buffer(&ss, StreamReadMode::THROUGHPUT, 1);
+    auto capacity = buffer.capacity();
+    REQUIRE(buffer.fill());
+    REQUIRE(buffer.string().size() == capacity);
+    buffer.consume(capacity - 10);
+    auto tail = std::string(buffer.string());
+    REQUIRE(buffer.fill());
+    auto str = buffer.string();
+    REQUIRE(str.size() == capacity);
+    REQUIRE(str.substr(0, 10) == tail);
+    REQUIRE(str.substr(10) == make_lines(2000).substr(capacity, capacity - 10));
+    REQUIRE(buffer.bytes_moved() == 0);
+}
+
+TEST_CASE("RingStreamBuffer: token longer than the ring")
+{
+    std::stringstream probe;
+    auto capacity = RingStreamBuffer(&probe, StreamReadMode::THROUGHPUT, 1).capacity();
+    std::string long_token(3 * capacity + 5, 'x');
+    std::stringstream ss("abc\n" + long_token + "\ndef");
+    size_t bytes_moved = 0;
+    auto tokens = get_tokens(RingStreamBuffer(&ss, StreamReadMode::THROUGHPUT, 1),
+                             bytes_moved);
+    REQUIRE(tokens == std::vector<std::string>{"abc", long_token, "def"});
+    REQUIRE(bytes_moved != 0);
+}
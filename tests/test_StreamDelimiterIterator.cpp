@@ -10,6 +10,7 @@
 #include <catch2/catch_test_macros.hpp>
 
 #include <sstream>
+#include <string>
 
 using namespace ParserTools;
 
@@ -31,3 +32,56 @@ TEST_CASE("False end of sequence at end of buffer_")
     REQUIRE(iterator.delimiter().empty());
     REQUIRE(iterator.remaining_buffer().empty());
 }
+
+TEST_CASE("Several delimiters in one buffer")
+{
+    std::stringstream ss("a,b,c,d,e,f,g,h,i,j");
+    StreamDelimiterIterator iterator(ss, FindChar(','), 6);
+    std::string result;
+    while (iterator.next())
+        result += iterator.preceding_substring();
+    REQUIRE(result == "abcdefghij");
+}
+
+TEST_CASE("Delimiter split across buffer refills")
+{
+    std::string str(100, 'x');
+    str += "\r\n--boundary";
+    str += std::string(50, 'y');
+    std::stringstream ss(str);
+    StreamDelimiterIterator iterator(ss, FindSubstring("\r\n--boundary"), 16);
+    REQUIRE(iterator.next());
+    REQUIRE(iterator.preceding_substring() == std::string(100, 'x'));
+    REQUIRE(iterator.delimiter() == "\r\n--boundary");
+    REQUIRE(iterator.next());
+    REQUIRE(iterator.preceding_substring() == std::string(50, 'y'));
+    REQUIRE(!iterator.next());
+}
+
+TEST_CASE("Multi-byte delimiter straddling a buffer fill")
+{
+    std::string str(10, 'x');
+    str += "\r\n--boundary";
+    str += std::string(50, 'y');
+    std::stringstream ss(str);
+    StreamDelimiterIterator iterator(ss, FindSubstring("\r\n--boundary"), 16);
+    REQUIRE(iterator.next());
+    REQUIRE(iterator.preceding_substring() == std::string(10, 'x'));
+    REQUIRE(iterator.delimiter() == "\r\n--boundary");
+    REQUIRE(iterator.next());
+    REQUIRE(iterator.preceding_substring() == std::string(50, 'y'));
+    REQUIRE(iterator.delimiter().empty());
+    REQUIRE(!iterator.next());
+}
+
+TEST_CASE("Longer substring completed after a buffer fill")
+{
+    std::stringstream ss("abcdefghijklm\r\n--b");
+    StreamDelimiterIterator iterator(ss, FindAnyOfSubstrings({"\r\n", "\r\n--"}), 16);
+    REQUIRE(iterator.next());
+    REQUIRE(iterator.preceding_substring() == "abcdefghijklm");
+    REQUIRE(iterator.delimiter() == "\r\n--");
+    REQUIRE(iterator.next());
+    REQUIRE(iterator.preceding_substring() == "b");
+    REQUIRE(!iterator.next());
+}
@@ -7,9 +7,11 @@
 //****************************************************************************
 #include "ParserTools/StreamTokenizer.hpp"
 #include "ParserTools/DelimiterFinders.hpp"
+#include "ParserTools/StringTokenizer.hpp"
 #include <catch2/catch_test_macros.hpp>
 
 #include <sstream>
+#include <vector>
 
 using namespace ParserTools;
 
@@ -49,3 +51,191 @@ TEST_CASE("Tokenize an empty stream")
     }
     REQUIRE(i == 1);
 }
+
+TEST_CASE("Tokenize a stream with FindAnyOfSubstrings")
+{
+    std::stringstream ss("a\r\n--b--c\r\nd");
+    std::vector<std::string> tokens;
+    for (auto item : tokenize(ss, FindAnyOfSubstrings({"\r\n", "--", "\r\n--"})))
+        tokens.emplace_back(item.string());
+    REQUIRE(tokens == std::vector<std::string>{"a", "b", "c", "d"});
+}
+
+namespace
+{
+    using TokenPairs = std::vector<std::pair<std::string, std::string>>;
+
+    template <typename Tokenizer>
+    TokenPairs get_token_pairs(Tokenizer&& tokenizer)
+    {
+        TokenPairs result;
+        for (auto item : tokenizer)
+            result.emplace_back(item.string(), item.token());
+        return result;
+    }
+
+    /**
+     * @brief Checks that tokenizing @a str as a stream gives the same
+     *  result as tokenizing it as a string.
+     */
+    template <typename FindDelimiterFunc>
+    void check_stream_tokens(const std::string& str, FindDelimiterFunc finder)
+    {
+        auto expected = get_token_pairs(tokenize(std::string_view(str), finder));
+        std::stringstream ss(str);
+        REQUIRE(get_token_pairs(tokenize(ss, finder)) == expected);
+    }
+}
+
+TEST_CASE("FindUnicodeWhitespace with a character split across stream buffer refills")
+{
+    std::string str(DEFAULT_STREAM_BUFFER_CAPACITY - 3, 'a');
+    str += "  \xE2\x80\x80" "b";
+    std::stringstream ss(str);
+    REQUIRE(get_token_pairs(tokenize(ss, FindUnicodeWhitespace()))
+            == TokenPairs{{std::string(DEFAULT_STREAM_BUFFER_CAPACITY - 3, 'a'),
+                           "  \xE2\x80\x80"},
+                          {"b", ""}});
+
+    for (size_t offset = 0; offset < 6; ++offset)
+    {
+        CAPTURE(offset);
+        str = std::string(DEFAULT_STREAM_BUFFER_CAPACITY - offset, 'a')
+              + " \xC2\xA0x\xE3\x80\x80y\xE2\x81";
+        check_stream_tokens(str, FindUnicodeWhitespace());
+    }
+}
+
+TEST_CASE("FindAnyOfSubstrings with a delimiter split across stream buffer refills")
+{
+    FindAnyOfSubstrings finder({"\r\n", "\r\n--"});
+    std::string str(DEFAULT_STREAM_BUFFER_CAPACITY - 3, 'a');
+    str += "\r\n--b";
+    std::stringstream ss(str);
+    REQUIRE(get_token_pairs(tokenize(ss, finder))
+            == TokenPairs{{std::string(DEFAULT_STREAM_BUFFER_CAPACITY - 3, 'a'), "\r\n--"},
+                          {"b", ""}});
+
+    for (size_t offset = 0; offset < 6; ++offset)
+    {
+        CAPTURE(offset);
+        str = std::string(DEFAULT_STREAM_BUFFER_CAPACITY - offset, 'a')
+              + "\r\n--b\r\nc\r\n-d";
+        check_stream_tokens(str, finder);
+    }
+}
+
+namespace
+{
+    struct CountingFindNewline
+    {
+        std::pair<size_t, size_t> operator()(std::string_view str)
+        {
+            *bytes_searched += str.size();
+            return FindNewline()(str);
+        }
+
+        [[nodiscard]]
+        size_t resume_position(std::string_view str, size_t start) const
+        {
+            return FindNewline().resume_position(str, start);
+        }
+
+        size_t* bytes_searched;
+    };
+}
+
+TEST_CASE("Tokenizing a long line only searches each byte once")
+{
+    std::string str(1000000, 'x');
+    str += "\r\nabc";
+    std::stringstream ss(str);
+    size_t bytes_searched = 0;
+    std::vector<size_t> sizes;
+    for (auto item : tokenize(ss, CountingFindNewline{&bytes_searched}))
+    {
+        sizes.push_back(item.string().size());
+        if (sizes.size() == 1)
+            REQUIRE(item.token() == "\r\n");
+    }
+    REQUIRE(sizes == std::vector<size_t>{1000000, 3});
+    REQUIRE(bytes_searched < 2 * str.size());
+}
+
+TEST_CASE("Delimiter split across stream buffer refills")
+{
+    std::string str(DEFAULT_STREAM_BUFFER_CAPACITY - 1, 'x');
+    str += "\r\nabc";
+    std::stringstream ss(str);
+    std::vector<std::string> tokens;
+    for (auto item : tokenize(ss, FindNewline()))
+        tokens.emplace_back(item.token());
+    REQUIRE(tokens == std::vector<std::string>{"\r\n", ""});
+}
+
+TEST_CASE("Multi-byte delimiter split across stream buffer refills")
+{
+    std::string str(DEFAULT_STREAM_BUFFER_CAPACITY - 5, 'x');
+    str += "\r\n--boundary";
+    str += std::string(50, 'y');
+    std::stringstream ss(str);
+    std::vector<std::string> tokens;
+    for (auto item : tokenize(ss, FindSubstring("\r\n--boundary")))
+        tokens.emplace_back(item.token());
+    REQUIRE(tokens == std::vector<std::string>{"\r\n--boundary", ""});
+}
+
+namespace
+{
+    /**
+     * @brief A streambuf that delivers its data in chunks, like a pipe
+     *  where the writer sends one chunk at a time.
+     */
+    class ChunkedStreambuf : public std::streambuf
+    {
+    public:
+        explicit ChunkedStreambuf(std::vector<std::string> chunks)
+            : chunks_(std::move(chunks))
+        {}
+
+        size_t chunks_read = 0;
+    protected:
+        int_type underflow() override
+        {
+            if (chunks_read == chunks_.size())
+                return traits_type::eof();
+            auto& chunk = chunks_[chunks_read++];
+            setg(chunk.data(), chunk.data(), chunk.data() + chunk.size());
+            return traits_type::to_int_type(chunk[0]);
+        }
+    private:
+        std::vector<std::string> chunks_;
+    };
+}
+
+TEST_CASE("Tokenize a stream in latency mode")
+{
+    ChunkedStreambuf buf({"line1\r\n", "line2\nli", "ne3\r", "\nline4"});
+    std::istream stream(&buf);
+    std::vector<std::string> lines;
+    std::vector<size_t> chunks_read;
+    auto buffer = StreamBuffer(&stream, StreamReadMode::LATENCY);
+    for (auto item : tokenize(std::move(buffer), FindNewline()))
+    {
+        lines.emplace_back(item.string());
+        chunks_read.push_back(buf.chunks_read);
+    }
+    REQUIRE(lines == std::vector<std::string>{"line1", "line2", "line3", "line4"});
+    // "line3\r" must wait for the next chunk to see if '\r' is followed by '\n'.
+    REQUIRE(chunks_read == std::vector<size_t>{1, 2, 4, 4});
+}
+
+TEST_CASE("Tokenize a stream in throughput mode")
+{
+    ChunkedStreambuf buf({"line1\n", "line2\n"});
+    std::istream stream(&buf);
+    std::vector<size_t> chunks_read;
+    for ([[maybe_unused]] auto item : tokenize(stream, FindNewline()))
+        chunks_read.push_back(buf.chunks_read);
+    REQUIRE(chunks_read == std::vector<size_t>{2, 2});
+}
@@ -9,6 +9,10 @@
 #include "ParserTools/DelimiterFinders.hpp"
 #include <catch2/catch_test_macros.hpp>
 
+#include <array>
+#include <memory>
+#include <string>
+
 using namespace ParserTools;
 
 TEST_CASE("StringTokenizer on comma-separated strings")
@@ -73,3 +77,137 @@ TEST_CASE("Split empty string.")
     REQUIRE(parts.size() == 1);
     REQUIRE(parts[0] == "");
 }
+
+TEST_CASE("Split into an output iterator")
+{
+    std::vector<std::string_view> parts;
+    split("a,b,,c", FindChar(','), std::back_inserter(parts));
+    REQUIRE(parts == std::vector<std::string_view>{"a", "b", "", "c"});
+    parts.clear();
+    split("a,b,,c", FindChar(','), std::back_inserter(parts), 2);
+    REQUIRE(parts == std::vector<std::string_view>{"a", "b", ",c"});
+}
+
+TEST_CASE("Split into a reusable vector")
+{
+    std::vector<std::string_view> parts;
+    REQUIRE(split("abc\ndef\r\nghijkl\rmnopq\n\r", FindNewline(), parts) == 6);
+    REQUIRE(parts == split("abc\ndef\r\nghijkl\rmnopq\n\r", FindNewline()));
+    REQUIRE(split("x,y", FindChar(','), parts) == 2);
+    REQUIRE(parts == std::vector<std::string_view>{"x", "y"});
+}
+
+TEST_CASE("Split into a span")
+{
+    std::array<std::string_view, 4> parts;
+    auto result = split("a,b,c", FindChar(','), std::span(parts));
+    REQUIRE(result.size == 3);
+    REQUIRE_FALSE(result.overflow);
+    REQUIRE(parts[2] == "c");
+
+    result = split("a,b,c,d", FindChar(','), std::span(parts));
+    REQUIRE(result.size == 4);
+    REQUIRE_FALSE(result.overflow);
+
+    result = split("a,b,c,d,", FindChar(','), std::span(parts));
+    REQUIRE(result.size == 4);
+    REQUIRE(result.overflow);
+    REQUIRE(parts[3] == "d,");
+
+    result = split("a,b,c,d,e,f", FindChar(','), std::span(parts), 2);
+    REQUIRE(result.size == 3);
+    REQUIRE_FALSE(result.overflow);
+    REQUIRE(parts[2] == "c,d,e,f");
+
+    result = split("a", FindChar(','), std::span(parts.data(), 0));
+    REQUIRE(result.size == 0);
+    REQUIRE(result.overflow);
+}
+
+TEST_CASE("Count split parts")
+{
+    REQUIRE(count_split_parts("", FindChar(',')) == 1);
+    REQUIRE(count_split_parts("a,b,", FindChar(',')) == 3);
+    REQUIRE(count_split_parts("a,b,c", FindChar(','), 1) == 2);
+    std::string_view str = "abc\ndef\r\nghijkl\rmnopq\n\r";
+    REQUIRE(count_split_parts(str, FindNewline()) == split(str, FindNewline()).size());
+}
+
+namespace
+{
+    /**
+     * @brief An allocator that counts the number of allocations.
+     */
+    template <typename T>
+    struct CountingAllocator
+    {
+        using value_type = T;
+
+        CountingAllocator() = default;
+
+        explicit CountingAllocator(size_t* count)
+            : count(count)
+        {}
+
+        template <typename U>
+        CountingAllocator(const CountingAllocator<U>& other)
+            : count(other.count)
+        {}
+
+        T* allocate(size_t n)
+        {
+            ++*count;
+            return std::allocator<T>().allocate(n);
+        }
+
+        void deallocate(T* p, size_t n)
+        {
+            std::allocator<T>().deallocate(p, n);
+        }
+
+        template <typename U>
+        friend bool operator==(const CountingAllocator& a,
+                               const CountingAllocator<U>& b)
+        {
+            return a.count == b.count;
+        }
+
+        size_t* count = nullptr;
+    };
+}
+
+TEST_CASE("Split a CSV line without allocating memory")
+{
+    size_t allocations = 0;
+    std::vector<std::string_view, CountingAllocator<std::string_view>>
+        vector_parts{CountingAllocator<std::string_view>(&allocations)};
+    split("warm,up,the,vector,with,more,than,six,parts", FindChar(','), vector_parts);
+    REQUIRE(allocations != 0);
+
+    allocations = 0;
+    std::string_view line = "2026-10-16,ABC,12.5,100,,N";
+    auto vector_size = split(line, FindChar(','), vector_parts);
+    REQUIRE(allocations == 0);
+    REQUIRE(vector_size == 6);
+    REQUIRE(vector_parts[4].empty());
+
+    // The span overload only writes to the given array.
+    std::array<std::string_view, 16> parts;
+    auto result = split(line, FindChar(','), std::span(parts));
+    REQUIRE(result.size == 6);
+    REQUIRE(parts[4].empty());
+}
+
+TEST_CASE("Tokenize with FindAnyOfSubstrings")
+{
+    FindAnyOfSubstrings finder({"\r\n", "--", "\r\n--"});
+    std::vector<std::string> tokens;
+    std::vector<size_t> delimiters;
+    for (auto item : tokenize("a\r\n--b--c\r\nd", finder))
+    {
+        tokens.emplace_back(item.string());
+        delimiters.push_back(finder.index_of(item.token()));
+    }
+    REQUIRE(tokens == std::vector<std::string>{"a", "b", "c", "d"});
+    REQUIRE(delimiters == std::vector<size_t>{2, 1, 0, NO_PATTERN});
+}
@@ -0,0 +1,96 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-16.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "ParserTools/SubstringSearch.hpp"
+#include "ParserTools/SimdLevel.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <random>
+#include <string>
+
+using namespace ParserTools;
+
+namespace
+{
+    size_t expected_find(std::string_view str, std::string_view needle)
+    {
+        return std::min(str.find(needle), str.size());
+    }
+
+    void check_find(std::string_view str, std::string_view needle)
+    {
+        SubstringSearcher searcher(needle);
+        auto expected = expected_find(str, needle);
+        for (auto level : {SimdLevel::SCALAR, SimdLevel::SSE2,
+                           SimdLevel::AVX2, SimdLevel::AVX512})
+        {
+            if (level > detected_simd_level())
+                break;
+            set_simd_level(level);
+            CAPTURE(int(level), str, needle);
+            REQUIRE(searcher.find(str) == expected);
+        }
+        set_simd_level(detected_simd_level());
+    }
+}
+
+TEST_CASE("SubstringSearcher with simple needles")
+{
+    check_find("", "");
+    check_find("abc", "");
+    check_find("abc", "d");
+    check_find("abc", "c");
+    check_find("ab", "abc");
+    check_find("Abc, def, ghi", ", ");
+    check_find("header\r\n--bound\r\n--boundary\r\nbody", "\r\n--boundary");
+}
+
+TEST_CASE("SubstringSearcher with periodic needles")
+{
+    std::string str(1000, 'a');
+    check_find(str, std::string(40, 'a') + "b");
+    check_find(str + "b", std::string(40, 'a') + "b");
+    check_find(str, std::string(5, 'a') + "b");
+    check_find(str + "b", std::string(5, 'a') + "b");
+    check_find(str, "b" + std::string(40, 'a'));
+
+    std::string abab;
+    for (int i = 0; i < 300; ++i)
+        abab += "ab";
+    check_find(abab, "ababababababac");
+    check_find(abab + "ac", "ababababababac");
+    check_find(abab + "c" + abab, abab.substr(0, 100) + "c");
+}
+
+TEST_CASE("SubstringSearcher with needles longer than the shift limit")
+{
+    std::string needle;
+    for (int i = 0; i < 400; ++i)
+        needle.push_back(char('a' + i % 23));
+    std::string str = needle.substr(100) + needle.substr(0, 399) + "x" + needle;
+    check_find(str, needle);
+    check_find(str.substr(0, str.size() - 1), needle);
+}
+
+TEST_CASE("SubstringSearcher on random strings")
+{
+    std::mt19937 rng(1234);
+    std::uniform_int_distribution<int> chars('a', 'c');
+    for (int n = 0; n < 300; ++n)
+    {
+        std::string str(size_t(rng() % 200), ' ');
+        for (auto& c : str)
+            c = char(chars(rng));
+        std::string needle(size_t(1 + rng() % 50), ' ');
+        for (auto& c : needle)
+            c = char(chars(rng));
+        check_find(str, needle);
+        if (str.size() > 10)
+            check_find(str, str.substr(rng() % (str.size() - 10), 2 + rng() % 8));
+    }
+}